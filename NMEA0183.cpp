@@ -25,29 +25,43 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #ifndef ARDUINO
 #include <cstdio>
 #endif
+#if defined(__linux__)||defined(__linux)||defined(linux)
+#include <poll.h>
+#include <time.h>
+#endif
 #include "NMEA0183.h"
+#include "NMEA0183Scan.h"
 
 //*****************************************************************************
-tNMEA0183::tNMEA0183(tNMEA0183Stream *stream, uint8_t _SourceID)
-: port(0), MsgCheckSumStartPos(SIZE_MAX),
-  MsgInPos(0), MsgInStarted(false),
+tNMEA0183Base::tNMEA0183Base(tNMEA0183MsgBase *_pMsgIn, tNMEA0183Stream *stream, uint8_t _SourceID)
+: port(0), pMsgIn(_pMsgIn), MsgInState(misNone), MsgInCheckSum(0),
+  TagLen(0), TagCheckSum(0), TagBlockReady(false), RxPos(0), RxLen(0),
   MsgOutWritePos(0), MsgOutReadPos(0), MsgOutBuf(0), MsgOutBufSize(3*MAX_NMEA0183_MSG_BUF_LEN),
-  MsgHandler(0)
+  RxRing(0), RxTime(0), RxByteTime(0), RxTimeData(0), Dispatcher(0), SubscriptionCount(0)
 {
   SetMessageStream(stream,_SourceID);
+  ResetStats();
+}
+
+//*****************************************************************************
+tNMEA0183Base::~tNMEA0183Base() {
+  delete Dispatcher;
+  delete[] MsgOutBuf;
 }
 
 //*****************************************************************************
-void tNMEA0183::SetMessageStream(tNMEA0183Stream *stream, uint8_t _SourceID) {
+void tNMEA0183Base::SetMessageStream(tNMEA0183Stream *stream, uint8_t _SourceID) {
   SourceID=_SourceID;
   port=stream;
 }
 
 //*****************************************************************************
-bool tNMEA0183::Open() {
+bool tNMEA0183Base::Open() {
   if ( !IsOpen() ) {
     if ( MsgOutBuf==0 ) MsgOutBuf=new char[MsgOutBufSize];
-    MsgInPos=0; MsgInStarted=false;
+    MsgInState=misNone;
+    TagBlockReady=false;
+    RxPos=0; RxLen=0;
     MsgOutWritePos=0; MsgOutReadPos=0;
 
     return IsOpen();
@@ -58,7 +72,7 @@ bool tNMEA0183::Open() {
 
 #ifdef ARDUINO
 //*****************************************************************************
-void tNMEA0183::Begin(HardwareSerial *_port, uint8_t _SourceID, unsigned long _baud) {
+void tNMEA0183Base::Begin(HardwareSerial *_port, uint8_t _SourceID, unsigned long _baud) {
   _port->begin(_baud);
   SetMessageStream(_port,_SourceID);
 
@@ -67,65 +81,289 @@ void tNMEA0183::Begin(HardwareSerial *_port, uint8_t _SourceID, unsigned long _b
 #endif
 
 //*****************************************************************************
-void tNMEA0183::SetSendBufferSize(size_t size) {
+void tNMEA0183Base::SetSendBufferSize(size_t size) {
   if ( MsgOutBuf==0 ) {
     MsgOutBufSize=size;
   }
 }
 
 //*****************************************************************************
-void tNMEA0183::ParseMessages() {
-  tNMEA0183Msg NMEA0183Msg;
+bool tNMEA0183Base::AddMsgHandler(const char *MessageCode, tNMEA0183ContextMsgHandler Handler, void *Context, const char *Sender) {
+  if ( Dispatcher==0 ) Dispatcher=new tNMEA0183Dispatcher();
+  return Dispatcher->AddHandler(MessageCode,Handler,Context,Sender);
+}
+
+//*****************************************************************************
+void tNMEA0183Base::SetDefaultMsgHandler(tNMEA0183ContextMsgHandler Handler, void *Context) {
+  if ( Dispatcher==0 ) Dispatcher=new tNMEA0183Dispatcher();
+  Dispatcher->SetDefaultHandler(Handler,Context);
+}
+
+//*****************************************************************************
+// Match pattern, where '?' matches any single character and '*' rest of string.
+static bool MatchPattern(const char *pattern, const char *str) {
+  for ( ; *pattern!=0; pattern++, str++ ) {
+    if ( *pattern=='*' ) return true;
+    if ( *str==0 || (*pattern!='?' && *pattern!=*str) ) return false;
+  }
+
+  return *str==0;
+}
+
+//*****************************************************************************
+bool tNMEA0183Base::Subscribe(const char *MessageCode, const char *Sender) {
+  if ( SubscriptionCount>=MAX_NMEA0183_SUBSCRIPTIONS ) return false;
+  if ( MessageCode==0 || MessageCode[0]==0 ) MessageCode="*";
+  if ( Sender==0 || Sender[0]==0 ) Sender="*";
+  if ( strlen(MessageCode)>MAX_NMEA0183_SUBSCRIPTION_CODE_LEN || strlen(Sender)>2 ) return false;
+
+  strcpy(Subscriptions[SubscriptionCount].Sender,Sender);
+  strcpy(Subscriptions[SubscriptionCount].MessageCode,MessageCode);
+  SubscriptionCount++;
+
+  return true;
+}
+
+//*****************************************************************************
+bool tNMEA0183Base::IsSubscribed(const char *Sender, const char *MessageCode) const {
+  if ( SubscriptionCount==0 ) return true;
 
-    if ( !Open() ) return;
+  for ( uint8_t i=0; i<SubscriptionCount; i++ ) {
+    if ( MatchPattern(Subscriptions[i].Sender,Sender) &&
+         MatchPattern(Subscriptions[i].MessageCode,MessageCode) ) return true;
+  }
+
+  return false;
+}
+
+//*****************************************************************************
+void tNMEA0183Base::HeaderReceived() {
+  if ( IsSubscribed(pMsgIn->Sender(),pMsgIn->MessageCode()) ) {
+    MsgInState=misData;
+  } else {
+    MsgInState=misNone;
+    Stats.Filtered++;
+  }
+}
 
-    while (GetMessage(NMEA0183Msg)) {
-      if (MsgHandler!=0) MsgHandler(NMEA0183Msg);
+//*****************************************************************************
+bool tNMEA0183Base::AddTagData(const char *buf, size_t len) {
+  if ( len>(size_t)(MAX_NMEA0183_TAG_LEN-TagLen) ) return false;
+
+  uint8_t cs=TagCheckSum;
+  for ( size_t i=0; i<len; i++ ) cs^=buf[i];
+  memcpy(TagBuf+TagLen,buf,len);
+  TagLen+=len;
+  TagCheckSum=cs;
+
+  return true;
+}
+
+//*****************************************************************************
+bool tNMEA0183Base::HandleByte(char NewByte) {
+  if (NewByte=='$' || NewByte=='!') { // Message start
+    if ( MsgInState!=misNone ) Stats.Errors++; // Previous message was not complete
+    pMsgIn->StartReceive(NewByte);
+    if ( TagBlockReady ) { // TAG block belongs to this message
+      pMsgIn->SetTagBlock(TagBlock);
+      TagBlockReady=false;
     }
-    kick();
+    MsgInState=( SubscriptionCount>0?misHeader:misData );
+    return false;
+  }
+
+  switch ( MsgInState ) {
+    case misNone:
+      if ( NewByte=='\\' ) { // TAG block start
+        TagLen=0;
+        TagCheckSum=0;
+        MsgInState=misTag;
+      }
+      break;
+    case misTag:
+      if ( NewByte=='*' ) {
+        MsgInState=misTagCheckSumHigh;
+      } else if ( !AddTagData(&NewByte,1) ) {
+        MsgInState=misNone;
+        Stats.Errors++;
+      }
+      break;
+    case misTagCheckSumHigh:
+      MsgInCheckSum=tNMEA0183MsgBase::HexToNibble(NewByte)<<4;
+      MsgInState=misTagCheckSumLow;
+      break;
+    case misTagCheckSumLow: // Checksum is checked at end, so that ending '\' will not start new TAG block
+      MsgInCheckSum|=tNMEA0183MsgBase::HexToNibble(NewByte);
+      MsgInState=misTagEnd;
+      break;
+    case misTagEnd:
+      MsgInState=misNone;
+      if ( NewByte=='\\' && MsgInCheckSum==TagCheckSum ) {
+        TagBlock.Parse(TagBuf,TagLen);
+        TagBlockReady=true;
+      } else {
+        Stats.Errors++;
+      }
+      break;
+    case misHeader:
+    case misData:
+      if ( NewByte=='*' ) {
+        MsgInState=( pMsgIn->EndReceiveData()?misCheckSumHigh:misNone );
+      } else if ( !pMsgIn->AddReceived(&NewByte,1) ) { // Invalid or too long message. Start from beginning
+        MsgInState=misNone;
+      } else if ( MsgInState==misHeader && NewByte==',' && pMsgIn->FieldCount()>0 ) {
+        HeaderReceived();
+        return false;
+      }
+      if ( MsgInState==misNone ) Stats.Errors++;
+      break;
+    case misCheckSumHigh:
+      MsgInCheckSum=tNMEA0183MsgBase::HexToNibble(NewByte)<<4;
+      MsgInState=misCheckSumLow;
+      break;
+    case misCheckSumLow: // We have full checksum and so full message
+      MsgInState=misNone;
+      if ( pMsgIn->EndReceive(MsgInCheckSum | tNMEA0183MsgBase::HexToNibble(NewByte)) ) {
+        pMsgIn->SourceID=SourceID;
+        Stats.Received++;
+        return true;
+      }
+      Stats.Errors++;
+      break;
+  }
+
+  return false;
 }
 
 //*****************************************************************************
-bool tNMEA0183::GetMessage(tNMEA0183Msg &NMEA0183Msg) {
-  if ( !IsOpen() ) return false;
+// Scan buffer for delimiters and add message data between them as whole spans.
+// Only delimiters and checksum characters go through HandleByte.
+size_t tNMEA0183Base::HandleBuf(const char *buf, size_t len, bool &MsgReady) {
+  const char *p=buf;
+  const char *end=buf+len;
+
+  MsgReady=false;
+  while ( p<end && !MsgReady ) {
+    if ( MsgInState==misNone ) { // Skip garbage between messages
+      const char *s=NMEA0183FindMsgStart(p,end);
+      // TAG block belongs only to sentence on same line.
+      if ( TagBlockReady && (memchr(p,'\r',s-p)!=0 || memchr(p,'\n',s-p)!=0) ) TagBlockReady=false;
+      p=s;
+      if ( p==end ) break;
+    } else if ( MsgInState==misHeader ) { // Add header until first ',' and check subscription
+      // Header is short, so simple loop is faster than scanner here.
+      const char *d=p;
+      for ( ; d<end && *d!=',' && *d!='*' && *d!='$' && *d!='!'; d++ );
+      const char *c=( d<end && *d==','?d:0 );
+      if ( c!=0 ) d=c+1;
+      if ( !pMsgIn->AddReceived(p,d-p) ) {
+        MsgInState=misNone; // Invalid or too long message. Start from beginning
+        Stats.Errors++;
+      } else if ( c!=0 && pMsgIn->FieldCount()>0 ) {
+        HeaderReceived();
+      }
+      p=d;
+      if ( c!=0 || p==end ) continue;
+    } else if ( MsgInState==misTag ) { // Add TAG block data until next delimiter
+      const char *d=NMEA0183FindMsgDelimiter(p,end);
+      if ( !AddTagData(p,d-p) ) { // Too long TAG block. Start from beginning
+        MsgInState=misNone;
+        Stats.Errors++;
+      }
+      p=d;
+      if ( p==end ) break;
+    } else if ( MsgInState==misData ) { // Add message data until next delimiter
+      const char *d=NMEA0183FindMsgDelimiter(p,end);
+      if ( !pMsgIn->AddReceived(p,d-p) ) { // Invalid or too long message. Start from beginning
+        MsgInState=misNone;
+        Stats.Errors++;
+      }
+      p=d;
+      if ( p==end ) break;
+    }
+    MsgReady=HandleByte(*p);
+    if ( (*p=='$' || *p=='!') && RxTime!=0 ) { // Message start arrival time
+      pMsgIn->_RxTime=RxTime+(uint64_t)(p-RxTimeData)*RxByteTime;
+    }
+    p++;
+  }
 
-  bool result=false;
+  return p-buf;
+}
 
-  while (port->available() > 0 && !result) {
+//*****************************************************************************
+size_t tNMEA0183Base::ReadPort(char *buf, size_t max) {
+  #ifdef ARDUINO
+  size_t n=0;
+
+  for ( ; n<max && port->available()>0; n++ ) {
     int NewByte=port->read();
-      if (NewByte=='$' || NewByte=='!') { // Message start
-        MsgInStarted=true;
-        MsgInPos=0;
-        MsgInBuf[MsgInPos]=NewByte;
-        MsgInPos++;
-      } else if (MsgInStarted) {
-        MsgInBuf[MsgInPos]=NewByte;
-        if (NewByte=='*') MsgCheckSumStartPos=MsgInPos;
-        MsgInPos++;
-        if (MsgCheckSumStartPos!=SIZE_MAX and MsgCheckSumStartPos+3==MsgInPos) { // We have full checksum and so full message
-            MsgInBuf[MsgInPos]=0; // add null termination
-          if (NMEA0183Msg.SetMessage(MsgInBuf)) {
-            NMEA0183Msg.SourceID=SourceID;
-            result=true;
-          }
-          MsgInStarted=false;
-          MsgInPos=0;
-          MsgCheckSumStartPos=SIZE_MAX;
-        }
-        if (MsgInPos>=MAX_NMEA0183_MSG_BUF_LEN) { // Too may chars in message. Start from beginning
-          MsgInStarted=false;
-          MsgInPos=0;
-          MsgCheckSumStartPos=SIZE_MAX;
-        }
-      }
+    if ( NewByte<0 ) break;
+    buf[n]=NewByte;
+  }
+
+  return n;
+  #else
+  if ( port->Restarted() ) ResetReceive(); // Data has been lost, so message under receiving is not valid.
+  size_t n=port->read((uint8_t *)buf,max);
+  if ( n>0 ) {
+    RxTime=port->GetReadTime(RxByteTime);
+    RxTimeData=buf;
+  }
+  return n;
+  #endif
+}
+
+//*****************************************************************************
+bool tNMEA0183Base::ReceiveMessage() {
+  bool result=false;
+
+  if ( RxRing!=0 ) { // Parse directly from ring memory
+    const char *data;
+    size_t len;
+
+    RxTime=0;  // Ring does not provide arrival time
+
+    while ( !result && (len=RxRing->ReadSpan(data))>0 ) {
+      RxRing->Consume(HandleBuf(data,len,result));
+    }
+
+    return result;
+  }
+
+  while ( !result ) {
+    if ( RxPos>=RxLen ) { // Receive buffer handled, so read next block
+      RxPos=0;
+      RxLen=ReadPort(RxBuf,MAX_NMEA0183_RX_BUF_LEN);
+      if ( RxLen==0 ) break;
+    }
+    RxPos+=HandleBuf(RxBuf+RxPos,RxLen-RxPos,result);
   }
 
   return result;
 }
 
 //*****************************************************************************
-bool tNMEA0183::SendMessage(const tNMEA0183Msg &NMEA0183Msg) {
-  if ( !Open() ) return false;
+bool tNMEA0183Base::GetMessage(tNMEA0183MsgBase &NMEA0183Msg) {
+  if ( !IsOpen() ) return false;
+
+  if ( !ReceiveMessage() ) return false;
+
+  return NMEA0183Msg.CopyFrom(*pMsgIn);
+}
+
+//*****************************************************************************
+bool tNMEA0183Base::SendMessage(const tNMEA0183MsgBase &NMEA0183Msg) {
+  if ( !Open() || port==0 ) return false;
+
+  #ifndef ARDUINO
+  // Format whole message, so that it will be written with one call.
+  char MsgBuf[264];  // Max message capacity 255, prefix, checksum and CR LF
+  if ( NMEA0183Msg.GetMessage(MsgBuf,sizeof(MsgBuf)-2) ) {
+    strcat(MsgBuf,"\r\n");
+    return SendBuf(MsgBuf);
+  }
+  #endif
 
   char buf[7]={NMEA0183Msg.GetPrefix(),0};
 
@@ -140,9 +378,80 @@ bool tNMEA0183::SendMessage(const tNMEA0183Msg &NMEA0183Msg) {
   return SendBuf(buf);
 }
 
+#if defined(__linux__)||defined(__linux)||defined(linux)
+//*****************************************************************************
+static uint64_t NMEA0183MonotonicMs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC,&ts);
+  return (uint64_t)ts.tv_sec*1000+ts.tv_nsec/1000000;
+}
+
+//*****************************************************************************
+bool tNMEA0183Base::WaitForData(uint32_t TimeoutMs) {
+  if ( !Open() ) return false;
+  if ( RxPos<RxLen ) return true;  // Unhandled data on receive buffer
+
+  uint64_t Deadline=NMEA0183MonotonicMs()+TimeoutMs;
+
+  if ( RxRing!=0 ) { // Ring has no descriptor
+    while ( RxRing->Available()==0 ) {
+      if ( NMEA0183MonotonicMs()>=Deadline ) return false;
+      kick();
+      poll(0,0,1);
+    }
+    return true;
+  }
+
+  for (;;) {
+    int ReadFd=port->GetReadFd();
+    uint64_t Now=NMEA0183MonotonicMs();
+    int Timeout=( Now<Deadline?(int)(Deadline-Now):0 );
+
+    if ( ReadFd==-1 ) { // E.g. connecting. Wait what stream asks.
+      struct pollfd pfd;
+      uint32_t MaxWaitMs;
+      if ( !port->GetPendingWait(pfd.fd,pfd.events,MaxWaitMs) ) {
+        if ( port->GetReadFd()!=-1 ) continue;  // Got descriptor e.g. connected
+        return true;
+      }
+      if ( Timeout==0 ) return false;
+      if ( MaxWaitMs<(uint32_t)Timeout ) Timeout=MaxWaitMs;
+      pfd.revents=0;
+      if ( poll(&pfd,1,Timeout)<0 ) return false;
+      continue;
+    }
+
+    struct pollfd fds[2];
+    nfds_t nfds=1;
+    fds[0].fd=ReadFd;
+    fds[0].events=POLLIN;
+    fds[0].revents=0;
+    if ( MsgOutWritePos!=MsgOutReadPos ) { // Pending output
+      int WriteFd=port->GetWriteFd();
+      if ( WriteFd==ReadFd ) {
+        fds[0].events|=POLLOUT;
+      } else if ( WriteFd!=-1 ) {
+        fds[1].fd=WriteFd;
+        fds[1].events=POLLOUT;
+        fds[1].revents=0;
+        nfds=2;
+      }
+    }
+
+    int res=poll(fds,nfds,Timeout);
+    if ( res<0 ) return false;   // Interrupted or error. Caller can just call again.
+    if ( res==0 ) return false;  // Timeout
+
+    if ( (fds[0].revents & POLLOUT) || (nfds==2 && fds[1].revents!=0) ) kick();
+    // Hang up or error is reported as data, so that caller reads and notices it.
+    if ( fds[0].revents & (POLLIN | POLLHUP | POLLERR) ) return true;
+  }
+}
+#endif
+
 //*****************************************************************************
 // availableForWrite does not exists on all implementations.
-bool tNMEA0183::CanSendByte() {
+bool tNMEA0183Base::CanSendByte() {
   #if defined(ARDUINO_ARCH_ESP32)
   return true;
   #else
@@ -151,17 +460,27 @@ bool tNMEA0183::CanSendByte() {
 }
 
 //*****************************************************************************
-void tNMEA0183::kick() {
-  if ( !Open() ) return;
+void tNMEA0183Base::kick() {
+  if ( !Open() || port==0 ) return;
 
+  #ifdef ARDUINO
   while ( MsgOutWritePos!=MsgOutReadPos && CanSendByte() ) {
     port->write(MsgOutBuf[MsgOutReadPos]);
     MsgOutReadPos=(MsgOutReadPos + 1) % MsgOutBufSize;
   }
+  #else
+  // Write continuous spans until stream does not accept more.
+  while ( MsgOutWritePos!=MsgOutReadPos ) {
+    size_t len=(MsgOutReadPos<MsgOutWritePos?MsgOutWritePos:MsgOutBufSize)-MsgOutReadPos;
+    size_t sent=port->write((const uint8_t *)MsgOutBuf+MsgOutReadPos,len);
+    if ( sent==0 || sent>len ) break;
+    MsgOutReadPos=(MsgOutReadPos + sent) % MsgOutBufSize;
+  }
+  #endif
 }
 
 //*****************************************************************************
-bool tNMEA0183::SendBuf(const char *buf) {
+bool tNMEA0183Base::SendBuf(const char *buf) {
   kick();
 
   if ( buf==0 ) return true;
@@ -169,9 +488,15 @@ bool tNMEA0183::SendBuf(const char *buf) {
   size_t iBuf=0;
 
   if ( MsgOutWritePos==MsgOutReadPos ) { // try to send immediately
+    #ifdef ARDUINO
     for (; CanSendByte() > 0 && buf[iBuf]!=0; iBuf++ ) {
       port->write(buf[iBuf]);
     }
+    #else
+    size_t len=strlen(buf);
+    iBuf=port->write((const uint8_t *)buf,len);
+    if ( iBuf>len ) iBuf=0;
+    #endif
   }
 
   if ( buf[iBuf]==0 ) {
@@ -199,8 +524,8 @@ bool tNMEA0183::SendBuf(const char *buf) {
 }
 
 //*****************************************************************************
-bool tNMEA0183::SendMessage(const char *buf) {
-  if ( !Open() ) return false;
+bool tNMEA0183Base::SendMessage(const char *buf) {
+  if ( !Open() || port==0 ) return false;
   // Add check that there is crlf at end.
   return SendBuf(buf);
 }
@@ -28,36 +28,133 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <stdint.h>
 #include "NMEA0183Stream.h"
 #include "NMEA0183Msg.h"
+#include "NMEA0183Dispatcher.h"
+#include "NMEA0183RxRing.h"
 
 #define MAX_NMEA0183_MSG_BUF_LEN 81  // According to NMEA 3.01. Can not contain multi message as in AIS
 
-class tNMEA0183
+// Receive buffer for reading port in blocks. Keep it small on Arduino, where
+// stream is anyway read byte by byte.
+#ifndef MAX_NMEA0183_RX_BUF_LEN
+#ifdef ARDUINO
+#define MAX_NMEA0183_RX_BUF_LEN 16
+#else
+#define MAX_NMEA0183_RX_BUF_LEN 512
+#endif
+#endif
+
+// Max count of message subscriptions. See tNMEA0183::Subscribe.
+#ifndef MAX_NMEA0183_SUBSCRIPTIONS
+#ifdef ARDUINO
+#define MAX_NMEA0183_SUBSCRIPTIONS 8
+#else
+#define MAX_NMEA0183_SUBSCRIPTIONS 32
+#endif
+#endif
+
+#define MAX_NMEA0183_SUBSCRIPTION_CODE_LEN 10
+
+// Receive statistics
+struct tNMEA0183Stats {
+  uint32_t Received; // Valid messages
+  uint32_t Filtered; // Messages dropped after header, since they were not subscribed
+  uint32_t Errors;   // Messages with invalid checksum or format
+};
+
+//------------------------------------------------------------------------------
+// Message stream handling. Storage for received message and typed message handler
+// are provided by tNMEA0183T.
+class tNMEA0183Base
 {
+  protected:
+    // Message receiving states
+    enum tMsgInState {
+                      misNone,         // Waiting for message start
+                      misHeader,       // Receiving sender and message code until first ','. Used only with subscriptions
+                      misData,         // Receiving message data until '*'
+                      misCheckSumHigh, // Waiting first checksum character
+                      misCheckSumLow,  // Waiting second checksum character
+                      misTag,          // Receiving TAG block data until '*'
+                      misTagCheckSumHigh,
+                      misTagCheckSumLow,
+                      misTagEnd        // Waiting '\' ending TAG block
+                    };
+    struct tSubscription {
+      char Sender[3];
+      char MessageCode[MAX_NMEA0183_SUBSCRIPTION_CODE_LEN+1];
+    };
   protected:
     tNMEA0183Stream *port;
-    size_t MsgCheckSumStartPos;
-    char MsgInBuf[MAX_NMEA0183_MSG_BUF_LEN];
-    size_t MsgInPos;
-    bool MsgInStarted;
+    tNMEA0183MsgBase *pMsgIn; // Message under receiving. Framing writes received data directly to it.
+    uint8_t MsgInState;
+    uint8_t MsgInCheckSum;
+    char TagBuf[MAX_NMEA0183_TAG_LEN];
+    uint8_t TagLen;
+    uint8_t TagCheckSum;
+    bool TagBlockReady;  // TagBlock has been received for next message
+    tNMEA0183TagBlock TagBlock;
+    char RxBuf[MAX_NMEA0183_RX_BUF_LEN];
+    size_t RxPos;
+    size_t RxLen;
     size_t MsgOutWritePos;
     size_t MsgOutReadPos;
     char *MsgOutBuf;
     size_t MsgOutBufSize;
     uint8_t SourceID;  // User defined ID for this message handler
+    tNMEA0183RxRing *RxRing; // Receive ring used instead of reading port.
+    // Arrival time of data block under framing. Byte at p arrived at
+    // RxTime+(p-RxTimeData)*RxByteTime. RxTime 0 means unknown.
+    uint64_t RxTime;
+    uint32_t RxByteTime;
+    const char *RxTimeData;
 
-    // Handler callback
-    void (*MsgHandler)(const tNMEA0183Msg &NMEA0183Msg);
+    // Handlers per message code. Allocated on first AddMsgHandler.
+    tNMEA0183Dispatcher *Dispatcher;
+
+    tSubscription Subscriptions[MAX_NMEA0183_SUBSCRIPTIONS];
+    uint8_t SubscriptionCount;
+    tNMEA0183Stats Stats;
 
     size_t MsgOutBufFreeSize() {
       return (MsgOutReadPos<MsgOutWritePos?MsgOutBufSize-(MsgOutWritePos-MsgOutReadPos):MsgOutBufSize+MsgOutReadPos-MsgOutWritePos);
     }
-    bool IsOpen() const { return ( port!=0 && MsgOutBuf!=0 ); }
+    bool IsOpen() const { return ( (port!=0 || RxRing!=0) && MsgOutBuf!=0 ); }
     bool SendBuf(const char *buf);
     bool CanSendByte();
+    // Read available data from port to buf. Returns count of bytes read.
+    size_t ReadPort(char *buf, size_t max);
+    // Forward valid pMsgIn to handlers added by AddMsgHandler.
+    void DispatchMsgIn() { if ( Dispatcher!=0 ) Dispatcher->Dispatch(*pMsgIn); }
+    // Add TAG block data between '\' and '*'. Returns false, if TAG block is too long.
+    bool AddTagData(const char *buf, size_t len);
+    // Header of pMsgIn has been received. Drops message, if it has not been subscribed.
+    void HeaderReceived();
+    // Run received byte through message framing. Returns true, when pMsgIn
+    // has new valid message.
+    bool HandleByte(char NewByte);
+    // Run received bytes through message framing until first valid message has been
+    // found or buffer has been handled. Returns count of bytes used.
+    size_t HandleBuf(const char *buf, size_t len, bool &MsgReady);
+    // Read port until pMsgIn has new valid message. Returns false, if there is no
+    // more data available.
+    bool ReceiveMessage();
+
+    // Message is storage of derived class, so it must not be used in constructor.
+    tNMEA0183Base(tNMEA0183MsgBase *_pMsgIn, tNMEA0183Stream *stream, uint8_t _SourceID);
+    ~tNMEA0183Base();
+    tNMEA0183Base(const tNMEA0183Base &)=delete;
+    tNMEA0183Base &operator=(const tNMEA0183Base &)=delete;
   public:
-    tNMEA0183(tNMEA0183Stream *stream=0, uint8_t _SourceID=0);
     void SetMessageStream(tNMEA0183Stream *stream, uint8_t _SourceID=0);
     tNMEA0183Stream *GetMessageStream() const { return port; }
+    // Receive from ring filled e.g. by UART interrupt or reader thread instead of
+    // reading message stream. Messages are parsed directly from ring memory. Message
+    // stream is then used only for sending and it can be 0. Set 0 to read stream again.
+    void SetRxRing(tNMEA0183RxRing *ring) { RxRing=ring; }
+    // Set arrival time of data given on next Feed call in ns since 1.1.1970. Time is
+    // for first byte of data and ByteTime is interval of following bytes e.g. on serial
+    // line (10e9/baud). Use 0 for data, which arrived at once like UDP datagram.
+    void SetFeedTime(uint64_t Time, uint32_t ByteTime=0) { RxTime=Time; RxByteTime=ByteTime; }
     bool Open();
     #ifdef ARDUINO
     // Begin is obsolete. Use Open(...)
@@ -65,21 +162,202 @@ class tNMEA0183
     #endif
     // Set size for send message buffer. Call this before Open().
     void SetSendBufferSize(size_t size);
-    // Set call back function, which will be called for new messages on ParseMessages.
-    void SetMsgHandler(void (*_MsgHandler)(const tNMEA0183Msg &NMEA0183Msg)) {MsgHandler=_MsgHandler;}
-    // Call this in loop to read incoming messages or empty buffered sent messages.
-    // For new messages message handler will be called.
-    void ParseMessages();
+    // Add handler with context for message code. Handler is found with hash lookup,
+    // so there is no need to compare message codes on own handler. If Sender is given,
+    // handler will be called only for that sender. Handlers are called on ParseMessages
+    // and Feed after handler set by SetMsgHandler. Returns false, if there is no room for handler.
+    bool AddMsgHandler(const char *MessageCode, tNMEA0183ContextMsgHandler Handler, void *Context=0, const char *Sender=0);
+    // Set handler with context for messages, which does not have handler added by AddMsgHandler
+    // matching their code and sender.
+    void SetDefaultMsgHandler(tNMEA0183ContextMsgHandler Handler, void *Context=0);
+    // Subscribe messages. Sender and MessageCode are patterns, where '?' matches
+    // any single character and '*' rest of the code. Sender 0 or "*" accepts any sender.
+    // E.g. Subscribe("RMC") accepts RMC from any talker, Subscribe("*","GP") all
+    // GP messages and Subscribe("VD?","AI") AIS VDM and VDO.
+    // Without subscriptions all messages will be accepted. With subscriptions message
+    // is dropped right after header without handling rest of it. Returns false,
+    // if there is no room for subscription or pattern is too long.
+    bool Subscribe(const char *MessageCode, const char *Sender=0);
+    // Remove all subscriptions so that all messages will be accepted.
+    void ClearSubscriptions() { SubscriptionCount=0; }
+    // Check is message with given sender and message code subscribed.
+    bool IsSubscribed(const char *Sender, const char *MessageCode) const;
+    // Receive statistics
+    const tNMEA0183Stats &GetStats() const { return Stats; }
+    void ResetStats() { Stats.Received=0; Stats.Filtered=0; Stats.Errors=0; }
+    // Drop partially received message and TAG block, e.g. when data has been lost or
+    // input is framed otherwise like UDP datagrams.
+    void ResetReceive() { MsgInState=misNone; TagBlockReady=false; }
     // You can also read incoming messages with GetMessage. Function
-    // returns true, when there is valid message.
-    bool GetMessage(tNMEA0183Msg &NMEA0183Msg);
+    // returns true, when there is valid message, which fits to NMEA0183Msg.
+    bool GetMessage(tNMEA0183MsgBase &NMEA0183Msg);
     // Function will send message immediately of buffer it. Call ParseMessages()
     // in loop so that buffered messages will be sent.
-    bool SendMessage(const tNMEA0183Msg &NMEA0183Msg);
+    bool SendMessage(const tNMEA0183MsgBase &NMEA0183Msg);
+    #if defined(__linux__)||defined(__linux)||defined(linux)
+    // Sleep in poll(2) until message stream has data to read or TimeoutMs has elapsed.
+    // Buffered messages are sent, when stream can be written. Returns true, if there
+    // is data to read. Stream temporarily without descriptor (e.g. connecting) is waited
+    // as its GetPendingWait tells. Other streams without descriptor can not be waited, so
+    // function returns true immediately for them. With receive ring function checks ring
+    // every ms.
+    bool WaitForData(uint32_t TimeoutMs);
+    #endif
+    #ifndef ARDUINO
+    // Descriptors of message stream for external poll or epoll loop. Return -1,
+    // if there is no stream or stream does not have descriptor.
+    int GetReadFd() const { return ( port!=0?port->GetReadFd():-1 ); }
+    int GetWriteFd() const { return ( port!=0?port->GetWriteFd():-1 ); }
+    // Call, when write descriptor is writable. Buffered messages are written until
+    // stream does not accept more. Returns true, when all buffered data has been written.
+    bool OnWritable() { kick(); return !HasPendingOutput(); }
+    #endif
+    // Check are there buffered messages waiting to be sent. Event loop should wait
+    // write descriptor to be writable only, when this is true.
+    bool HasPendingOutput() const { return MsgOutWritePos!=MsgOutReadPos; }
 
     // These are obsolete. Use SendMessage
     bool SendMessage(const char *buf);
     void kick();
 };
 
+//------------------------------------------------------------------------------
+// Message stream handler for messages with capacity MsgLen characters and MaxFields
+// fields. Longer messages will be dropped.
+template<uint16_t MsgLen, uint16_t MaxFields>
+class tNMEA0183T : public tNMEA0183Base
+{
+  public:
+    typedef tNMEA0183MsgT<MsgLen,MaxFields> tMsg;
+    typedef void (*tMsgHandler)(const tMsg &NMEA0183Msg);
+    typedef void (*tMsgBatchHandler)(const tMsg *NMEA0183Msgs, size_t Count);
+
+  protected:
+    tMsg MsgInBuf;
+    // Handler callback
+    tMsgHandler MsgHandler;
+    // Batch delivery. Framing writes messages directly to batch slots.
+    tMsgBatchHandler MsgBatchHandler;
+    tMsg *MsgBatch;
+    size_t MsgBatchSize;
+    size_t MsgBatchCount;
+
+    tMsg &CurrentMsgIn() { return *static_cast<tMsg *>(pMsgIn); }
+
+    void HandleMsgIn(tMsgHandler _MsgHandler) {
+      if ( _MsgHandler!=0 ) _MsgHandler(CurrentMsgIn());
+      DispatchMsgIn();
+      if ( MsgBatch!=0 ) { // Keep message on batch and continue to next slot
+        MsgBatchCount++;
+        if ( MsgBatchCount==MsgBatchSize ) {
+          FlushMsgBatch();
+        } else {
+          pMsgIn=MsgBatch+MsgBatchCount;
+        }
+      }
+    }
+
+    // Deliver collected messages. Message under receiving continues on first slot.
+    void FlushMsgBatch() {
+      if ( MsgBatch==0 ) return;
+      if ( MsgBatchCount>0 && MsgBatchHandler!=0 ) MsgBatchHandler(MsgBatch,MsgBatchCount);
+      if ( pMsgIn!=MsgBatch && MsgInState!=misNone ) MsgBatch[0]=CurrentMsgIn();
+      pMsgIn=MsgBatch;
+      MsgBatchCount=0;
+    }
+
+  public:
+    tNMEA0183T(tNMEA0183Stream *stream=0, uint8_t _SourceID=0)
+      : tNMEA0183Base(&MsgInBuf,stream,_SourceID), MsgHandler(0),
+        MsgBatchHandler(0), MsgBatch(0), MsgBatchSize(0), MsgBatchCount(0) {}
+    ~tNMEA0183T() { delete[] MsgBatch; }
+    // Set call back function, which will be called for new messages on ParseMessages.
+    void SetMsgHandler(tMsgHandler _MsgHandler) { MsgHandler=_MsgHandler; }
+    // Set call back function, which will be called with collected messages. Messages
+    // are collected until MaxBatchSize messages has been received or ParseMessages or
+    // Feed has handled all available data. Messages are valid only during call.
+    // Handler set by SetMsgHandler and handlers added with AddMsgHandler will still be
+    // called for each message. Set 0 to stop batch delivery.
+    void SetMsgBatchHandler(tMsgBatchHandler _MsgBatchHandler, size_t MaxBatchSize=16) {
+      delete[] MsgBatch;
+      MsgBatch=0;
+      MsgBatchCount=0;
+      pMsgIn=&MsgInBuf;
+      MsgInState=misNone;
+      MsgBatchHandler=_MsgBatchHandler;
+      if ( MsgBatchHandler!=0 && MaxBatchSize>0 ) {
+        MsgBatch=new tMsg[MaxBatchSize];
+        MsgBatchSize=MaxBatchSize;
+        pMsgIn=MsgBatch;
+      }
+    }
+    // Call this in loop to read incoming messages or empty buffered sent messages.
+    // For new messages message handler will be called.
+    void ParseMessages() {
+      if ( !Open() ) return;
+
+      while ( ReceiveMessage() ) HandleMsgIn(MsgHandler);
+      FlushMsgBatch();
+      kick();
+    }
+    #ifndef ARDUINO
+    // Call, when read descriptor is readable. Stream will be read until it does not
+    // have more data (read returns EAGAIN), so this can be used with edge triggered
+    // epoll. Message handlers will be called for received messages. Returns count of
+    // valid messages.
+    size_t OnReadable() {
+      size_t MsgCount=0;
+
+      if ( !Open() ) return 0;
+      while ( ReceiveMessage() ) {
+        MsgCount++;
+        HandleMsgIn(MsgHandler);
+      }
+      FlushMsgBatch();
+
+      return MsgCount;
+    }
+    #endif
+    #if defined(__linux__)||defined(__linux)||defined(linux)
+    // Wait data up to TimeoutMs and then parse messages. Use this on loop instead of
+    // ParseMessages() to avoid spinning, when there is no data.
+    void ParseMessages(uint32_t TimeoutMs) {
+      if ( !Open() ) return;
+
+      if ( WaitForData(TimeoutMs) ) ParseMessages();
+    }
+    #endif
+    // Feed block of received data e.g. from log file or UDP/TCP socket directly to
+    // message framing. Given handler, or message handler set by SetMsgHandler, if
+    // handler is 0, will be called for every valid message found. Handlers added
+    // by AddMsgHandler will be called too. Incomplete message at end of data will be
+    // continued on next call. Function does not use message stream, so it can be
+    // used without Open(). Messages get arrival time set by SetFeedTime before call.
+    // Returns count of valid messages.
+    size_t Feed(const char *data, size_t len, tMsgHandler _MsgHandler=0) {
+      if ( data==0 ) return 0;
+      if ( _MsgHandler==0 ) _MsgHandler=MsgHandler;
+
+      size_t MsgCount=0;
+      bool MsgReady;
+
+      RxTimeData=data;
+      while ( len>0 ) {
+        size_t used=HandleBuf(data,len,MsgReady);
+        data+=used; len-=used;
+        if ( MsgReady ) {
+          MsgCount++;
+          HandleMsgIn(_MsgHandler);
+        }
+      }
+      FlushMsgBatch();
+      RxTime=0;  // Time set with SetFeedTime is valid only for one call
+
+      return MsgCount;
+    }
+};
+
+// Message stream handler with default message capacity.
+typedef tNMEA0183T<MAX_NMEA0183_MSG_LEN,MAX_NMEA0183_MSG_FIELDS> tNMEA0183;
+
 #endif
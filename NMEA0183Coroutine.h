@@ -0,0 +1,341 @@
+/*
+NMEA0183Coroutine.h
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+C++20 coroutine interface for receiving messages. Message handling can be
+written as sequential code, which waits next message with
+  const tNMEA0183MsgBase *Msg=co_await Source.NextMessage("RMC",2000);
+instead of state machine on message handler. Waiting coroutine does not use
+thread. It is resumed, when tNMEA0183CoSource gets matching message or wait
+times out. tNMEA0183CoLoop sleeps in poll(2) on descriptors of sources until
+data arrives or next wait expires.
+
+Available only, when compiler supports coroutines (e.g. -std=c++20) and not on Arduino.
+*/
+
+#ifndef _NMEA0183COROUTINE_H_
+#define _NMEA0183COROUTINE_H_
+
+#if !defined(ARDUINO) && defined(__cpp_impl_coroutine)
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <thread>
+#include <vector>
+#if defined(__linux__)||defined(__linux)||defined(linux)
+#include <poll.h>
+#endif
+#include "NMEA0183.h"
+
+typedef std::chrono::steady_clock tNMEA0183CoClock;
+
+//------------------------------------------------------------------------------
+// Return type for coroutine tasks. Task starts immediately and frees itself,
+// when it returns. E.g.
+//   tNMEA0183Task TrackRoute(tNMEA0183CoSource &Source) { for (;;) { auto Msg=co_await Source.NextMessage("RTE"); ... } }
+class tNMEA0183Task
+{
+  public:
+    struct promise_type {
+      tNMEA0183Task get_return_object() { return tNMEA0183Task(); }
+      std::suspend_never initial_suspend() noexcept { return {}; }
+      std::suspend_never final_suspend() noexcept { return {}; }
+      void return_void() {}
+      void unhandled_exception() { std::terminate(); }
+    };
+};
+
+class tNMEA0183CoSource;
+class tNMEA0183CoLoop;
+
+//------------------------------------------------------------------------------
+// Awaiter returned by tNMEA0183CoSource::NextMessage. Awaiter lives in
+// coroutine frame and is linked to source while waiting, so waiting does not
+// allocate memory.
+class tNMEA0183MsgAwaiter
+{
+  friend class tNMEA0183CoSource;
+  protected:
+    tNMEA0183CoSource *Source;
+    uint64_t CodeKey;  // 0 for any message
+    bool HasTimeout;
+    tNMEA0183CoClock::time_point Deadline;
+    std::coroutine_handle<> Handle;
+    const tNMEA0183MsgBase *Msg;
+    tNMEA0183MsgAwaiter *Next;
+
+  public:
+    tNMEA0183MsgAwaiter(tNMEA0183CoSource *_Source, uint64_t _CodeKey, bool _HasTimeout, tNMEA0183CoClock::time_point _Deadline)
+      : Source(_Source), CodeKey(_CodeKey), HasTimeout(_HasTimeout), Deadline(_Deadline), Msg(0), Next(0) {}
+    bool await_ready() const noexcept { return false; }
+    inline void await_suspend(std::coroutine_handle<> _Handle);
+    // Returns received message or 0 on timeout. Message is valid until coroutine
+    // suspends next time.
+    const tNMEA0183MsgBase *await_resume() const noexcept { return Msg; }
+};
+
+//------------------------------------------------------------------------------
+// Message source for coroutines. Source reads messages from tNMEA0183 with
+// GetMessage on Poll. Messages can be also given with Deliver or by setting
+// MsgHandler as tNMEA0183 context handler, e.g.
+//   NMEA0183.SetDefaultMsgHandler(tNMEA0183CoSource::MsgHandler,&Source);
+class tNMEA0183CoSource
+{
+  friend class tNMEA0183MsgAwaiter;
+  protected:
+    tNMEA0183Base *NMEA0183;
+    tNMEA0183Msg Msg;
+    tNMEA0183MsgAwaiter *Waiters; // Waiting coroutines in wait order
+    tNMEA0183MsgAwaiter *LastWaiter;
+
+    void AddWaiter(tNMEA0183MsgAwaiter *Waiter) {
+      Waiter->Next=0;
+      if ( LastWaiter!=0 ) LastWaiter->Next=Waiter; else Waiters=Waiter;
+      LastWaiter=Waiter;
+    }
+
+    // Take waiters for which Resume returns true and resume them. Coroutines
+    // may start new waits while resumed, so they are added to new list.
+    template<class tResume>
+    size_t ResumeWaiters(tResume Resume) {
+      tNMEA0183MsgAwaiter *Waiter=Waiters;
+      size_t Count=0;
+
+      Waiters=LastWaiter=0;
+      while ( Waiter!=0 ) {
+        tNMEA0183MsgAwaiter *Next=Waiter->Next;
+        if ( Resume(Waiter) ) {
+          Waiter->Handle.resume(); // Waiter may not be used after resume
+          Count++;
+        } else {
+          AddWaiter(Waiter);
+        }
+        Waiter=Next;
+      }
+      return Count;
+    }
+
+  public:
+    tNMEA0183CoSource(tNMEA0183Base *_NMEA0183=0) : NMEA0183(_NMEA0183), Waiters(0), LastWaiter(0) {}
+    // Destroys coroutines still waiting on this source.
+    ~tNMEA0183CoSource() {
+      while ( Waiters!=0 ) {
+        tNMEA0183MsgAwaiter *Waiter=Waiters;
+        Waiters=Waiter->Next;
+        if ( Waiters==0 ) LastWaiter=0;
+        Waiter->Handle.destroy();
+      }
+    }
+    tNMEA0183CoSource(const tNMEA0183CoSource &)=delete;
+    tNMEA0183CoSource &operator=(const tNMEA0183CoSource &)=delete;
+
+    // Wait next message. MessageCode 0 accepts any message.
+    tNMEA0183MsgAwaiter NextMessage(const char *MessageCode=0) {
+      return tNMEA0183MsgAwaiter(this,(MessageCode!=0?NMEA0183Code(MessageCode):0),false,tNMEA0183CoClock::time_point());
+    }
+    // Wait next message for TimeoutMs. Wait returns 0 on timeout.
+    tNMEA0183MsgAwaiter NextMessage(const char *MessageCode, uint32_t TimeoutMs) {
+      return tNMEA0183MsgAwaiter(this,(MessageCode!=0?NMEA0183Code(MessageCode):0),true,
+                                 tNMEA0183CoClock::now()+std::chrono::milliseconds(TimeoutMs));
+    }
+    // Resume coroutines waiting for Msg. Returns count of resumed coroutines.
+    size_t Deliver(const tNMEA0183MsgBase &_Msg) {
+      return ResumeWaiters([&_Msg](tNMEA0183MsgAwaiter *Waiter) {
+        if ( Waiter->CodeKey!=0 && !_Msg.IsMessageCode(Waiter->CodeKey) ) return false;
+        Waiter->Msg=&_Msg;
+        return true;
+      });
+    }
+    // Context message handler for tNMEA0183::AddMsgHandler or SetDefaultMsgHandler.
+    static void MsgHandler(const tNMEA0183MsgBase &_Msg, void *Context) {
+      ((tNMEA0183CoSource *)Context)->Deliver(_Msg);
+    }
+    // Read available messages from tNMEA0183 and deliver them. Returns count of messages.
+    size_t Poll() {
+      size_t Count=0;
+      if ( NMEA0183==0 ) return 0;
+      while ( NMEA0183->GetMessage(Msg) ) {
+        Deliver(Msg);
+        Count++;
+      }
+      return Count;
+    }
+    // Resume waits, which have timed out at Now. NextDeadline will be set to
+    // earliest deadline still waiting, if it is earlier than given.
+    size_t CheckTimeouts(tNMEA0183CoClock::time_point Now, tNMEA0183CoClock::time_point &NextDeadline) {
+      size_t Count=ResumeWaiters([Now](tNMEA0183MsgAwaiter *Waiter) { return Waiter->HasTimeout && Waiter->Deadline<=Now; });
+      for ( tNMEA0183MsgAwaiter *Waiter=Waiters; Waiter!=0; Waiter=Waiter->Next ) {
+        if ( Waiter->HasTimeout && Waiter->Deadline<NextDeadline ) NextDeadline=Waiter->Deadline;
+      }
+      return Count;
+    }
+    bool HasWaiters() const { return Waiters!=0; }
+    // Read descriptor of message stream or -1, if source can not be waited with it.
+    int GetReadFd() const { return ( NMEA0183!=0?NMEA0183->GetReadFd():-1 ); }
+    // Source reads tNMEA0183, which does not have descriptor (e.g. receive ring), so
+    // it must be polled periodically.
+    bool NeedsPolling() const { return NMEA0183!=0 && GetReadFd()==-1; }
+};
+
+//*****************************************************************************
+void tNMEA0183MsgAwaiter::await_suspend(std::coroutine_handle<> _Handle) {
+  Handle=_Handle;
+  Source->AddWaiter(this);
+}
+
+//------------------------------------------------------------------------------
+// Awaiter returned by tNMEA0183CoLoop::Sleep.
+class tNMEA0183SleepAwaiter
+{
+  friend class tNMEA0183CoLoop;
+  protected:
+    tNMEA0183CoLoop *Loop;
+    tNMEA0183CoClock::time_point Deadline;
+    std::coroutine_handle<> Handle;
+    tNMEA0183SleepAwaiter *Next;
+
+  public:
+    tNMEA0183SleepAwaiter(tNMEA0183CoLoop *_Loop, tNMEA0183CoClock::time_point _Deadline) : Loop(_Loop), Deadline(_Deadline), Next(0) {}
+    bool await_ready() const noexcept { return false; }
+    inline void await_suspend(std::coroutine_handle<> _Handle);
+    void await_resume() const noexcept {}
+};
+
+//------------------------------------------------------------------------------
+// Event loop for coroutines. Loop reads added sources and resumes coroutines
+// waiting for messages, timeouts or Sleep. Between rounds Run sleeps in poll(2)
+// on source descriptors until data arrives or next deadline. Sources without
+// descriptor are polled every IdleMs. Coroutines are resumed on thread calling
+// Run or RunOnce.
+class tNMEA0183CoLoop
+{
+  friend class tNMEA0183SleepAwaiter;
+  protected:
+    std::vector<tNMEA0183CoSource *> Sources;
+    tNMEA0183SleepAwaiter *Sleepers;
+    bool Stopped;
+    uint32_t IdleMs;
+    #if defined(__linux__)||defined(__linux)||defined(linux)
+    std::vector<struct pollfd> PollFds;
+    #endif
+
+  public:
+    // IdleMs is poll interval of sources without descriptor.
+    tNMEA0183CoLoop(uint32_t _IdleMs=1) : Sleepers(0), Stopped(false), IdleMs(_IdleMs) {}
+    // Destroys coroutines still sleeping.
+    ~tNMEA0183CoLoop() {
+      while ( Sleepers!=0 ) {
+        tNMEA0183SleepAwaiter *Sleeper=Sleepers;
+        Sleepers=Sleeper->Next;
+        Sleeper->Handle.destroy();
+      }
+    }
+    tNMEA0183CoLoop(const tNMEA0183CoLoop &)=delete;
+    tNMEA0183CoLoop &operator=(const tNMEA0183CoLoop &)=delete;
+
+    void AddSource(tNMEA0183CoSource *Source) { Sources.push_back(Source); }
+    // Suspend coroutine for Ms milliseconds.
+    tNMEA0183SleepAwaiter Sleep(uint32_t Ms) {
+      return tNMEA0183SleepAwaiter(this,tNMEA0183CoClock::now()+std::chrono::milliseconds(Ms));
+    }
+    // Read sources once and resume coroutines with expired waits. NextDeadline is
+    // set to earliest pending deadline, Now+IdleMs, if some source needs polling,
+    // or time_point::max(), if there is none. Returns count of handled messages
+    // and resumed timeouts.
+    size_t RunOnce(tNMEA0183CoClock::time_point &NextDeadline) {
+      size_t Count=0;
+      bool Polling=false;
+
+      for ( size_t i=0; i<Sources.size(); i++ ) {
+        Count+=Sources[i]->Poll();
+        Polling|=Sources[i]->NeedsPolling();
+      }
+      tNMEA0183CoClock::time_point Now=tNMEA0183CoClock::now();
+      #if !defined(__linux__) && !defined(__linux) && !defined(linux)
+      Polling=true;  // Without poll(2) loop can only sleep IdleMs
+      #endif
+      NextDeadline=( Polling?Now+std::chrono::milliseconds(IdleMs):tNMEA0183CoClock::time_point::max() );
+      for ( size_t i=0; i<Sources.size(); i++ ) Count+=Sources[i]->CheckTimeouts(Now,NextDeadline);
+
+      tNMEA0183SleepAwaiter *Sleeper=Sleepers;
+      Sleepers=0;
+      while ( Sleeper!=0 ) { // Sleep started by resumed coroutine will be added to Sleepers
+        tNMEA0183SleepAwaiter *Next=Sleeper->Next;
+        if ( Sleeper->Deadline<=Now ) {
+          Sleeper->Handle.resume();
+          Count++;
+        } else {
+          if ( Sleeper->Deadline<NextDeadline ) NextDeadline=Sleeper->Deadline;
+          Sleeper->Next=Sleepers;
+          Sleepers=Sleeper;
+        }
+        Sleeper=Next;
+      }
+      return Count;
+    }
+    size_t RunOnce() { tNMEA0183CoClock::time_point NextDeadline; return RunOnce(NextDeadline); }
+    // Sleep until some source descriptor has data to read or Deadline. Returns
+    // true, if there is data.
+    bool WaitEvents(tNMEA0183CoClock::time_point Deadline) {
+      #if defined(__linux__)||defined(__linux)||defined(linux)
+      PollFds.clear();
+      for ( size_t i=0; i<Sources.size(); i++ ) {
+        int fd=Sources[i]->GetReadFd();
+        if ( fd!=-1 ) PollFds.push_back({fd,POLLIN,0});
+      }
+      int TimeoutMs=-1;
+      if ( Deadline!=tNMEA0183CoClock::time_point::max() ) { // Round up, so that deadline has passed on wake up
+        auto Wait=std::chrono::ceil<std::chrono::milliseconds>(Deadline-tNMEA0183CoClock::now()).count();
+        TimeoutMs=( Wait<0?0:(Wait>INT32_MAX?INT32_MAX:(int)Wait) );
+      }
+      return poll(PollFds.data(),PollFds.size(),TimeoutMs)>0;
+      #else
+      std::this_thread::sleep_until(Deadline);
+      return false;
+      #endif
+    }
+    // Run until Stop has been called or there are no waiting coroutines. When
+    // there is nothing to do, sleeps until source has data or next deadline.
+    void Run() {
+      Stopped=false;
+      while ( !Stopped && HasWaiters() ) {
+        tNMEA0183CoClock::time_point NextDeadline;
+        if ( RunOnce(NextDeadline)==0 && !Stopped ) WaitEvents(NextDeadline);
+      }
+    }
+    void Stop() { Stopped=true; }
+    bool HasWaiters() const {
+      if ( Sleepers!=0 ) return true;
+      for ( size_t i=0; i<Sources.size(); i++ ) if ( Sources[i]->HasWaiters() ) return true;
+      return false;
+    }
+};
+
+//*****************************************************************************
+void tNMEA0183SleepAwaiter::await_suspend(std::coroutine_handle<> _Handle) {
+  Handle=_Handle;
+  Next=Loop->Sleepers;
+  Loop->Sleepers=this;
+}
+
+#endif
+
+#endif
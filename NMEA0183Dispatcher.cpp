@@ -0,0 +1,91 @@
+/*
+NMEA0183Dispatcher.cpp
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#include <string.h>
+#include "NMEA0183Dispatcher.h"
+
+//*****************************************************************************
+tNMEA0183Dispatcher::tNMEA0183Dispatcher() {
+  Clear();
+}
+
+//*****************************************************************************
+void tNMEA0183Dispatcher::Clear() {
+  for ( size_t i=0; i<MAX_NMEA0183_MSG_HANDLERS; i++ ) Handlers[i].Handler=0;
+  HandlerCount=0;
+  DefaultHandler=0;
+  DefaultContext=0;
+}
+
+//*****************************************************************************
+// Table index from packed message code. Multiplication mixes all code characters to
+// high bits.
+size_t tNMEA0183Dispatcher::CodeIndex(uint64_t MessageCode) {
+  uint32_t Hash=(uint32_t)(MessageCode ^ (MessageCode>>32))*2654435761UL;
+
+  return (Hash>>16) & (MAX_NMEA0183_MSG_HANDLERS-1);
+}
+
+//*****************************************************************************
+bool tNMEA0183Dispatcher::AddHandler(const char *MessageCode, tNMEA0183ContextMsgHandler Handler, void *Context, const char *Sender) {
+  if ( Handler==0 || MessageCode==0 || MessageCode[0]==0 ) return false;
+  if ( Sender!=0 && strlen(Sender)>2 ) return false;
+  if ( HandlerCount>=MAX_NMEA0183_MSG_HANDLERS-1 ) return false; // Keep one free slot to end probing
+
+  uint64_t Code=NMEA0183Code(MessageCode);
+  if ( Code==NMEA0183CodeNA ) return false;
+
+  size_t i=CodeIndex(Code);
+
+  // Linear probing. Handlers for same code stay in adding order.
+  while ( Handlers[i].Handler!=0 ) i=(i+1) & (MAX_NMEA0183_MSG_HANDLERS-1);
+
+  Handlers[i].Handler=Handler;
+  Handlers[i].Context=Context;
+  Handlers[i].MessageCode=Code;
+  Handlers[i].Sender=( Sender!=0?NMEA0183Sender(Sender):0 );
+  HandlerCount++;
+
+  return true;
+}
+
+//*****************************************************************************
+bool tNMEA0183Dispatcher::Dispatch(const tNMEA0183MsgBase &NMEA0183Msg) const {
+  if ( HandlerCount>0 ) {
+    uint64_t Code=NMEA0183Msg.MessageCodeKey();
+    size_t i=CodeIndex(Code);
+
+    for ( ; Handlers[i].Handler!=0; i=(i+1) & (MAX_NMEA0183_MSG_HANDLERS-1) ) {
+      const tHandler &h=Handlers[i];
+      if ( h.MessageCode==Code && (h.Sender==0 || h.Sender==NMEA0183Msg.SenderKey()) ) {
+        h.Handler(NMEA0183Msg,h.Context);
+        return true;
+      }
+    }
+  }
+
+  if ( DefaultHandler!=0 ) DefaultHandler(NMEA0183Msg,DefaultContext);
+
+  return false;
+}
@@ -0,0 +1,86 @@
+/*
+NMEA0183Dispatcher.h
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+Message dispatcher, which calls handler registered for message code. Handlers
+are kept in hash table so that finding handler does not depend on count of
+registered handlers.
+*/
+
+#ifndef _NMEA0183DISPATCHER_H_
+#define _NMEA0183DISPATCHER_H_
+
+#include <stdint.h>
+#include "NMEA0183Msg.h"
+
+// Size of handler table. Must be power of 2.
+#ifndef MAX_NMEA0183_MSG_HANDLERS
+#ifdef ARDUINO
+#define MAX_NMEA0183_MSG_HANDLERS 16
+#else
+#define MAX_NMEA0183_MSG_HANDLERS 64
+#endif
+#endif
+
+#if (MAX_NMEA0183_MSG_HANDLERS & (MAX_NMEA0183_MSG_HANDLERS-1))!=0
+#error MAX_NMEA0183_MSG_HANDLERS must be power of 2
+#endif
+
+// Message handler with user context
+typedef void (*tNMEA0183ContextMsgHandler)(const tNMEA0183MsgBase &NMEA0183Msg, void *Context);
+
+//------------------------------------------------------------------------------
+class tNMEA0183Dispatcher
+{
+  protected:
+    struct tHandler {
+      tNMEA0183ContextMsgHandler Handler; // 0 for free slot
+      void *Context;
+      uint64_t MessageCode; // Packed with NMEA0183Code
+      uint16_t Sender;      // Packed with NMEA0183Sender. 0 for any sender
+    };
+
+  protected:
+    tHandler Handlers[MAX_NMEA0183_MSG_HANDLERS];
+    uint8_t HandlerCount;
+    tNMEA0183ContextMsgHandler DefaultHandler;
+    void *DefaultContext;
+
+    static size_t CodeIndex(uint64_t MessageCode);
+
+  public:
+    tNMEA0183Dispatcher();
+    // Add handler for message code. If Sender is given, handler will be called only
+    // for messages from that sender. If there are several handlers for same code,
+    // first added matching handler will be called, so add sender specific handlers
+    // first. Returns false, if table is full or code is invalid. Message code can
+    // have at most 8 characters.
+    bool AddHandler(const char *MessageCode, tNMEA0183ContextMsgHandler Handler, void *Context=0, const char *Sender=0);
+    // Set handler for messages, which does not have matching handler for code and sender.
+    void SetDefaultHandler(tNMEA0183ContextMsgHandler Handler, void *Context=0) { DefaultHandler=Handler; DefaultContext=Context; }
+    // Remove all handlers.
+    void Clear();
+    // Call handler for message. Returns false, if there was no handler for message.
+    // Default handler is called only, when no handler matches message code and sender.
+    bool Dispatch(const tNMEA0183MsgBase &NMEA0183Msg) const;
+};
+
+#endif
@@ -37,7 +37,7 @@ Inherited tNMEA0183Stream object for Linux
 
 
 //*****************************************************************************
-tNMEA0183LinuxStream::tNMEA0183LinuxStream(const char *_port) : port(-1) {
+tNMEA0183LinuxStream::tNMEA0183LinuxStream(const char *_port) : port(-1), Bridge(_port==0) {
   if ( _port!=0 ) {
     port=open(_port, O_RDWR | O_NOCTTY | O_NDELAY);
   }
@@ -64,8 +64,9 @@ tNMEA0183LinuxStream::~tNMEA0183LinuxStream() {
 *
 **********************************************************************/
 int tNMEA0183LinuxStream:: read() {
-  if ( port!=-1 ) {
-    return -1;
+  if ( !Bridge ) {
+    uint8_t c;
+    return ( port!=-1 && ::read(port,&c,1)==1?c:-1 );
   } else {
     // Serial stream bridge -- Returns first byte if incoming data, or -1 on no available data.
     struct timeval tv = { 0L, 0L };
@@ -81,11 +82,33 @@ int tNMEA0183LinuxStream:: read() {
 }
 
 
+//*****************************************************************************
+size_t tNMEA0183LinuxStream::read(uint8_t *buf, size_t max) {
+  int fd=port;
+
+  if ( Bridge ) {
+    // Serial stream bridge -- read from stdin, if there is something waiting.
+    struct timeval tv = { 0L, 0L };
+    fd_set fds;
+
+    FD_ZERO(&fds);
+    FD_SET(0, &fds);
+    if (select(1, &fds, NULL, NULL, &tv) <= 0) return 0;
+    fd=0;
+  } else if ( fd==-1 ) { // Port could not be opened
+    return 0;
+  }
+
+  ssize_t n=::read(fd,buf,max);                                                 // One read for all available data
+
+  return ( n>0?n:0 );
+}
 
 //*****************************************************************************
 size_t tNMEA0183LinuxStream:: write(const uint8_t* data, size_t size) {                // Serial Stream bridge -- Write data to stream.
-  if ( port!=-1 ) {
-    return ::write(port,data,size);
+  if ( !Bridge ) {
+    ssize_t n=( port!=-1?::write(port,data,size):0 );                           // Non blocking port may accept only part of data
+    return ( n>0?n:0 );
   } else {
     size_t i;
 
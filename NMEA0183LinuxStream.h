@@ -34,11 +34,18 @@ Inherited tNMEA0183Stream object for Linux
 class tNMEA0183LinuxStream : public tNMEA0183Stream {
 protected:
   int port;
+  bool Bridge;  // No port given, so stdin and stdout are used
 public:
     tNMEA0183LinuxStream(const char *_port=0);
     virtual ~tNMEA0183LinuxStream();
     int read();
+    size_t read(uint8_t *buf, size_t max);
     size_t write(const uint8_t* data, size_t size);
+    // Check was port given to constructor opened.
+    bool IsOpen() const { return port!=-1; }
+    // Port descriptor or stdin/stdout for bridge without port. -1, if port could not be opened.
+    int GetReadFd() const { return ( Bridge?0:port ); }
+    int GetWriteFd() const { return ( Bridge?1:port ); }
 };
 #endif
 
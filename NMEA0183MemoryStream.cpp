@@ -0,0 +1,71 @@
+/*
+NMEA0183MemoryStream.cpp
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#ifndef ARDUINO
+
+#include <string.h>
+#include "NMEA0183MemoryStream.h"
+
+//*****************************************************************************
+tNMEA0183MemoryStream::tNMEA0183MemoryStream(size_t Size) {
+  size_t RingSize=2;
+  while ( RingSize<Size ) RingSize<<=1;
+  Buf=new char[RingSize];
+  Ring=new tNMEA0183RxRing(Buf,RingSize);
+}
+
+//*****************************************************************************
+tNMEA0183MemoryStream::~tNMEA0183MemoryStream() {
+  delete Ring;
+  delete[] Buf;
+}
+
+//*****************************************************************************
+int tNMEA0183MemoryStream::read() {
+  return Ring->Read();
+}
+
+//*****************************************************************************
+size_t tNMEA0183MemoryStream::read(uint8_t *buf, size_t max) {
+  size_t Total=0;
+  const char *data;
+
+  // Data may be in two parts around end of ring.
+  for (size_t n; Total<max && (n=Ring->ReadSpan(data))>0; Total+=n) {
+    if ( n>max-Total ) n=max-Total;
+    memcpy(buf+Total,data,n);
+    Ring->Consume(n);
+  }
+
+  return Total;
+}
+
+//*****************************************************************************
+size_t tNMEA0183MemoryStream::write(const uint8_t* data, size_t size) {
+  size_t Free=Ring->Free();
+  if ( size>Free ) size=Free;
+  return Ring->Push((const char *)data,size);
+}
+
+#endif
@@ -0,0 +1,62 @@
+/*
+NMEA0183MemoryStream.h
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+In-memory stream for tests and benchmarks on non Arduino platforms. Data written
+to stream is stored to ring buffer and read back from it, so one stream can be
+used as loopback port for tNMEA0183, or shared between sending tNMEA0183 on one
+thread and receiving tNMEA0183 on other thread. Write accepts only data fitting
+to ring, so full ring behaves like full port.
+*/
+
+#ifndef _NMEA0183_MEMORY_STREAM_H_
+#define _NMEA0183_MEMORY_STREAM_H_
+
+#include "NMEA0183Stream.h"
+#include "NMEA0183RxRing.h"
+
+#ifndef ARDUINO
+//-----------------------------------------------------------------------------
+class tNMEA0183MemoryStream : public tNMEA0183Stream {
+protected:
+  tNMEA0183RxRing *Ring;
+  char *Buf;
+
+public:
+  // Size is rounded up to power of 2.
+  tNMEA0183MemoryStream(size_t Size=4096);
+  virtual ~tNMEA0183MemoryStream();
+  tNMEA0183MemoryStream(const tNMEA0183MemoryStream &)=delete;
+  tNMEA0183MemoryStream &operator=(const tNMEA0183MemoryStream &)=delete;
+
+  // Reading side. Call only from one thread.
+  int available() { return Ring->Available(); }
+  int read();
+  size_t read(uint8_t *buf, size_t max);
+
+  // Writing side. Call only from one thread.
+  int availableForWrite() { return Ring->Free(); }
+  size_t write(const uint8_t* data, size_t size);
+  using tNMEA0183Stream::write;
+};
+#endif
+
+#endif /* _NMEA0183_MEMORY_STREAM_H_ */
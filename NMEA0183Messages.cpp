@@ -111,11 +111,23 @@ double NMEA0183GPTimeToSeconds(const char *data) {
 }
 
 //*****************************************************************************
-time_t NMEA0183GPSDateTimetotime_t(const char *dateStr, const char *timeStr, time_t defDate) {
+// Copy field to null terminated string. Field may not be null terminated, so
+// field length will be used.
+template<class tMsg>
+static void CopyField(const tMsg &NMEA0183Msg, uint8_t index, char *dst, size_t dstSize) {
+  size_t len=NMEA0183Msg.FieldLen(index);
+
+  if ( len>dstSize-1 ) len=dstSize-1;
+  memcpy(dst,NMEA0183Msg.Field(index),len);
+  dst[len]=0;
+}
+
+//*****************************************************************************
+static time_t GPSDateTimetotime_t(const char *dateStr, size_t dateLen, const char *timeStr, size_t timeLen, time_t defDate) {
   tmElements_t TimeElements;
   char StrCvt[3]="00";
 
-    if (dateStr!=0 && strlen(dateStr)==6) {
+    if (dateStr!=0 && dateLen==6) {
       StrCvt[0]=dateStr[0]; StrCvt[1]=dateStr[1];
       tNMEA0183Msg::SetDay(TimeElements,atoi(StrCvt));
       StrCvt[0]=dateStr[2]; StrCvt[1]=dateStr[3];
@@ -128,7 +140,7 @@ time_t NMEA0183GPSDateTimetotime_t(const char *dateStr, const char *timeStr, tim
       tNMEA0183Msg::breakTime(defDate,TimeElements);
     }
 
-    if (timeStr!=0 && strlen(timeStr)>=6) {
+    if (timeStr!=0 && timeLen>=6) {
       StrCvt[0]=timeStr[0]; StrCvt[1]=timeStr[1];
       tNMEA0183Msg::SetHour(TimeElements,atoi(StrCvt));
       StrCvt[0]=timeStr[2]; StrCvt[1]=timeStr[3];
@@ -144,9 +156,14 @@ time_t NMEA0183GPSDateTimetotime_t(const char *dateStr, const char *timeStr, tim
     return tNMEA0183Msg::makeTime(TimeElements);
 }
 
+//*****************************************************************************
+time_t NMEA0183GPSDateTimetotime_t(const char *dateStr, const char *timeStr, time_t defDate) {
+  return GPSDateTimetotime_t(dateStr,(dateStr!=0?strlen(dateStr):0),timeStr,(timeStr!=0?strlen(timeStr):0),defDate);
+}
+
 //*****************************************************************************
 // $IIDBx,32.0,f,10.5,M,5.7,F*hh
-bool NMEA0183SetDepth(tNMEA0183Msg &NMEA0183Msg, const char *Prefix, double Depth, const char *Src) {
+bool NMEA0183SetDepth(tNMEA0183MsgBase &NMEA0183Msg, const char *Prefix, double Depth, const char *Src) {
   if ( !NMEA0183Msg.Init(Prefix,Src) ) return false;
   if ( !NMEA0183Msg.AddDoubleField(Depth,mToFeet,tNMEA0183Msg::DefDoubleFormat,"f") ) return false;
   if ( !NMEA0183Msg.AddDoubleField(Depth,1,tNMEA0183Msg::DefDoubleFormat,"M") ) return false;
@@ -157,24 +174,24 @@ bool NMEA0183SetDepth(tNMEA0183Msg &NMEA0183Msg, const char *Prefix, double Dept
 
 //*****************************************************************************
 // $IIDBK,32.0,f,10.5,M,5.7,F*hh
-bool NMEA0183SetDBK(tNMEA0183Msg &NMEA0183Msg, double Depth, const char *Src) {
+bool NMEA0183SetDBK(tNMEA0183MsgBase &NMEA0183Msg, double Depth, const char *Src) {
   return NMEA0183SetDepth(NMEA0183Msg,"DBK",Depth,Src);
 }
 
 //*****************************************************************************
 // $IIDBS,32.0,f,10.5,M,5.7,F*hh
-bool NMEA0183SetDBS(tNMEA0183Msg &NMEA0183Msg, double Depth, const char *Src) {
+bool NMEA0183SetDBS(tNMEA0183MsgBase &NMEA0183Msg, double Depth, const char *Src) {
   return NMEA0183SetDepth(NMEA0183Msg,"DBS",Depth,Src);
 }
 
 //*****************************************************************************
 // $IIDBT,32.0,f,10.5,M,5.7,F*hh
-bool NMEA0183SetDBT(tNMEA0183Msg &NMEA0183Msg, double Depth, const char *Src) {
+bool NMEA0183SetDBT(tNMEA0183MsgBase &NMEA0183Msg, double Depth, const char *Src) {
   return NMEA0183SetDepth(NMEA0183Msg,"DBT",Depth,Src);
 }
 
 //*****************************************************************************
-bool NMEA0183SetDBx(tNMEA0183Msg &NMEA0183Msg, double DepthBelowTransducer, double Offset, const char *Src) {
+bool NMEA0183SetDBx(tNMEA0183MsgBase &NMEA0183Msg, double DepthBelowTransducer, double Offset, const char *Src) {
   if ( !NMEA0183IsNA(Offset) ) {
     double Depth=( !NMEA0183IsNA(DepthBelowTransducer)?DepthBelowTransducer+Offset:DepthBelowTransducer );
     if ( Offset>0 ) {
@@ -193,7 +210,8 @@ bool NMEA0183SetDBx(tNMEA0183Msg &NMEA0183Msg, double DepthBelowTransducer, doub
 //
 
 //expecting NMEA0183 3.0. It includes Range field (must handle value/empty field/no field)
-bool NMEA0183ParseDPT_nc(const tNMEA0183Msg &NMEA0183Msg,  double &DepthBelowTransducer, double &Offset, double &Range ) {
+template<class tMsg>
+static bool ParseDPT_nc(const tMsg &NMEA0183Msg,  double &DepthBelowTransducer, double &Offset, double &Range ) {
 	bool result=( NMEA0183Msg.FieldCount()>= 2);
 	if ( result ) {
 		DepthBelowTransducer=NMEA0183GetDouble(NMEA0183Msg.Field(0));
@@ -206,8 +224,17 @@ bool NMEA0183ParseDPT_nc(const tNMEA0183Msg &NMEA0183Msg,  double &DepthBelowTra
 	return result;
 }
 
+bool NMEA0183ParseDPT_nc(const tNMEA0183MsgBase &NMEA0183Msg, double &DepthBelowTransducer, double &Offset, double &Range) {
+  return ParseDPT_nc(NMEA0183Msg,DepthBelowTransducer,Offset,Range);
+}
+
+bool NMEA0183ParseDPT_nc(const tNMEA0183MsgView &NMEA0183Msg, double &DepthBelowTransducer, double &Offset, double &Range) {
+  return ParseDPT_nc(NMEA0183Msg,DepthBelowTransducer,Offset,Range);
+}
+
 //expecting NMEA0183 before 3.0. it did not include Range field,  ignore it
-bool NMEA0183ParseDPT_nc(const tNMEA0183Msg &NMEA0183Msg,  double &DepthBelowTransducer, double &Offset ) {
+template<class tMsg>
+static bool ParseDPT_nc(const tMsg &NMEA0183Msg,  double &DepthBelowTransducer, double &Offset ) {
 	bool result=( NMEA0183Msg.FieldCount()>= 2);
 	if ( result ) {
 		DepthBelowTransducer=NMEA0183GetDouble(NMEA0183Msg.Field(0));
@@ -216,7 +243,15 @@ bool NMEA0183ParseDPT_nc(const tNMEA0183Msg &NMEA0183Msg,  double &DepthBelowTra
 	return result;
 }
 
-bool NMEA0183SetDPT(tNMEA0183Msg &NMEA0183Msg, double DepthBelowTransducer, double Offset, double Range, const char *Src, const char *DepthFormat) {
+bool NMEA0183ParseDPT_nc(const tNMEA0183MsgBase &NMEA0183Msg, double &DepthBelowTransducer, double &Offset) {
+  return ParseDPT_nc(NMEA0183Msg,DepthBelowTransducer,Offset);
+}
+
+bool NMEA0183ParseDPT_nc(const tNMEA0183MsgView &NMEA0183Msg, double &DepthBelowTransducer, double &Offset) {
+  return ParseDPT_nc(NMEA0183Msg,DepthBelowTransducer,Offset);
+}
+
+bool NMEA0183SetDPT(tNMEA0183MsgBase &NMEA0183Msg, double DepthBelowTransducer, double Offset, double Range, const char *Src, const char *DepthFormat) {
   if ( !NMEA0183Msg.Init("DPT",Src) ) return false;
   if ( !NMEA0183Msg.AddDoubleField(DepthBelowTransducer, 1, DepthFormat) ) return false;
   if ( !NMEA0183Msg.AddDoubleField(Offset, 1, DepthFormat) ) return false;
@@ -224,7 +259,7 @@ bool NMEA0183SetDPT(tNMEA0183Msg &NMEA0183Msg, double DepthBelowTransducer, doub
   return true;
 }
 
-bool NMEA0183SetDPT(tNMEA0183Msg &NMEA0183Msg, double DepthBelowTransducer, double Offset, const char *Src, const char *DepthFormat) {
+bool NMEA0183SetDPT(tNMEA0183MsgBase &NMEA0183Msg, double DepthBelowTransducer, double Offset, const char *Src, const char *DepthFormat) {
   if ( !NMEA0183Msg.Init("DPT",Src) ) return false;
   if ( !NMEA0183Msg.AddDoubleField(DepthBelowTransducer, 1, DepthFormat) ) return false;
   if ( !NMEA0183Msg.AddDoubleField(Offset, 1, DepthFormat) ) return false;
@@ -234,7 +269,8 @@ bool NMEA0183SetDPT(tNMEA0183Msg &NMEA0183Msg, double DepthBelowTransducer, doub
 
 //*****************************************************************************
 // $GPGGA,182435.00,6023.20859,N,02219.99442,E,2,10,0.9,4.0,M,20.6,M,5.0,0120*4D
-bool NMEA0183ParseGGA_nc(const tNMEA0183Msg &NMEA0183Msg, double &GPSTime, double &Latitude, double &Longitude,
+template<class tMsg>
+static bool ParseGGA_nc(const tMsg &NMEA0183Msg, double &GPSTime, double &Latitude, double &Longitude,
                       int &GPSQualityIndicator, int &SatelliteCount, double &HDOP, double &Altitude, double &GeoidalSeparation,
                       double &DGPSAge, int &DGPSReferenceStationID) {
   bool result=( NMEA0183Msg.FieldCount()>=14 );
@@ -257,8 +293,16 @@ bool NMEA0183ParseGGA_nc(const tNMEA0183Msg &NMEA0183Msg, double &GPSTime, doubl
   return result;
 }
 
+bool NMEA0183ParseGGA_nc(const tNMEA0183MsgBase &NMEA0183Msg, double &GPSTime, double &Latitude, double &Longitude, int &GPSQualityIndicator, int &SatelliteCount, double &HDOP, double &Altitude, double &GeoidalSeparation, double &DGPSAge, int &DGPSReferenceStationID) {
+  return ParseGGA_nc(NMEA0183Msg,GPSTime,Latitude,Longitude,GPSQualityIndicator,SatelliteCount,HDOP,Altitude,GeoidalSeparation,DGPSAge,DGPSReferenceStationID);
+}
+
+bool NMEA0183ParseGGA_nc(const tNMEA0183MsgView &NMEA0183Msg, double &GPSTime, double &Latitude, double &Longitude, int &GPSQualityIndicator, int &SatelliteCount, double &HDOP, double &Altitude, double &GeoidalSeparation, double &DGPSAge, int &DGPSReferenceStationID) {
+  return ParseGGA_nc(NMEA0183Msg,GPSTime,Latitude,Longitude,GPSQualityIndicator,SatelliteCount,HDOP,Altitude,GeoidalSeparation,DGPSAge,DGPSReferenceStationID);
+}
+
 //*****************************************************************************
-bool NMEA0183SetGGA(tNMEA0183Msg &NMEA0183Msg, double GPSTime, double Latitude, double Longitude,
+bool NMEA0183SetGGA(tNMEA0183MsgBase &NMEA0183Msg, double GPSTime, double Latitude, double Longitude,
           	uint32_t GPSQualityIndicator, uint32_t SatelliteCount, double HDOP, double Altitude, double GeoidalSeparation,
 	          double DGPSAge, uint32_t DGPSReferenceStationID, const char *Src) {
 
@@ -280,7 +324,8 @@ bool NMEA0183SetGGA(tNMEA0183Msg &NMEA0183Msg, double GPSTime, double Latitude,
 //*****************************************************************************
 //$GPGLL,5246.241,N,00506.648,E,155957,A*2B
 //$GPGLL,,,,,155648,*5B
-bool NMEA0183ParseGLL_nc(const tNMEA0183Msg &NMEA0183Msg, tGLL &GLL) {
+template<class tMsg>
+static bool ParseGLL_nc(const tMsg &NMEA0183Msg, tGLL &GLL) {
 
   bool result=( NMEA0183Msg.FieldCount()>= 6);
 
@@ -293,8 +338,16 @@ bool NMEA0183ParseGLL_nc(const tNMEA0183Msg &NMEA0183Msg, tGLL &GLL) {
   return result;
 }
 
+bool NMEA0183ParseGLL_nc(const tNMEA0183MsgBase &NMEA0183Msg, tGLL &GLL) {
+  return ParseGLL_nc(NMEA0183Msg,GLL);
+}
+
+bool NMEA0183ParseGLL_nc(const tNMEA0183MsgView &NMEA0183Msg, tGLL &GLL) {
+  return ParseGLL_nc(NMEA0183Msg,GLL);
+}
+
 //*****************************************************************************
-bool NMEA0183SetGLL(tNMEA0183Msg &NMEA0183Msg, double GPSTime, double Latitude, double Longitude, const char *Src) {
+bool NMEA0183SetGLL(tNMEA0183MsgBase &NMEA0183Msg, double GPSTime, double Latitude, double Longitude, const char *Src) {
 
   if ( !NMEA0183Msg.Init("GLL",Src) ) return false;
   if ( !NMEA0183Msg.AddLatitudeField(Latitude) ) return false;
@@ -313,7 +366,8 @@ bool NMEA0183SetGLL(tNMEA0183Msg &NMEA0183Msg, double GPSTime, double Latitude,
 
 //*****************************************************************************
 //$GPRMB,A,0.15,R,WOUBRG,WETERB,5213.400,N,00438.400,E,009.4,180.2,,V*07
-bool NMEA0183ParseRMB_nc(const tNMEA0183Msg &NMEA0183Msg, tRMB &RMB) {
+template<class tMsg>
+static bool ParseRMB_nc(const tMsg &NMEA0183Msg, tRMB &RMB) {
 
   bool result=( NMEA0183Msg.FieldCount()>=13 );
 
@@ -324,10 +378,8 @@ bool NMEA0183ParseRMB_nc(const tNMEA0183Msg &NMEA0183Msg, tRMB &RMB) {
   RMB.xte=atof(NMEA0183Msg.Field(1))*nmTom;
 	//Left is negative in NMEA2000. Right is positive.
 	if (NMEA0183Msg.Field(2)[0]=='R') RMB.xte=-RMB.xte;
-    strncpy(RMB.originID,NMEA0183Msg.Field(3),sizeof(RMB.originID)/sizeof(char));
-    RMB.originID[sizeof(RMB.originID)/sizeof(char)-1]='\0';
-    strncpy(RMB.destID,NMEA0183Msg.Field(4),sizeof(RMB.destID)/sizeof(char));
-    RMB.destID[sizeof(RMB.destID)/sizeof(char)-1]='\0';
+    CopyField(NMEA0183Msg,3,RMB.originID,sizeof(RMB.originID));
+    CopyField(NMEA0183Msg,4,RMB.destID,sizeof(RMB.destID));
     RMB.latitude=LatLonToDouble(NMEA0183Msg.Field(5),NMEA0183Msg.Field(6)[0]);
     RMB.longitude=LatLonToDouble(NMEA0183Msg.Field(7),NMEA0183Msg.Field(8)[0]);
     RMB.dtw=atof(NMEA0183Msg.Field(9))*nmTom;
@@ -340,9 +392,18 @@ bool NMEA0183ParseRMB_nc(const tNMEA0183Msg &NMEA0183Msg, tRMB &RMB) {
 
 }
 
+bool NMEA0183ParseRMB_nc(const tNMEA0183MsgBase &NMEA0183Msg, tRMB &RMB) {
+  return ParseRMB_nc(NMEA0183Msg,RMB);
+}
+
+bool NMEA0183ParseRMB_nc(const tNMEA0183MsgView &NMEA0183Msg, tRMB &RMB) {
+  return ParseRMB_nc(NMEA0183Msg,RMB);
+}
+
 //*****************************************************************************
 // $GPRMC,092348.00,A,6035.04228,N,02115.15472,E,0.01,272.61,060815,7.2,E,D*34
-bool NMEA0183ParseRMC_nc(const tNMEA0183Msg &NMEA0183Msg, double &GPSTime, char &Status, double &Latitude, double &Longitude,
+template<class tMsg>
+static bool ParseRMC_nc(const tMsg &NMEA0183Msg, double &GPSTime, char &Status, double &Latitude, double &Longitude,
                       double &TrueCOG, double &SOG, unsigned long &DaysSince1970, double &Variation, time_t *DateTime) {
   bool result=( NMEA0183Msg.FieldCount()>=11 );
 
@@ -356,7 +417,7 @@ bool NMEA0183ParseRMC_nc(const tNMEA0183Msg &NMEA0183Msg, double &GPSTime, char
     SOG=atof(NMEA0183Msg.Field(6))*knToms;
     TrueCOG=atof(NMEA0183Msg.Field(7))*degToRad;
 
-    lDT=NMEA0183GPSDateTimetotime_t(NMEA0183Msg.Field(8),0);
+    lDT=GPSDateTimetotime_t(NMEA0183Msg.Field(8),NMEA0183Msg.FieldLen(8),0,0,NMEA0183time_tNA);
     if ( !NMEA0183IsTimeNA(lDT) ) {
       if ( !NMEA0183IsNA(GPSTime) ) lDT+=floor(GPSTime);
       DaysSince1970=tNMEA0183Msg::elapsedDaysSince1970(lDT);
@@ -369,8 +430,16 @@ bool NMEA0183ParseRMC_nc(const tNMEA0183Msg &NMEA0183Msg, double &GPSTime, char
   return result;
 }
 
+bool NMEA0183ParseRMC_nc(const tNMEA0183MsgBase &NMEA0183Msg, double &GPSTime, char &Status, double &Latitude, double &Longitude, double &TrueCOG, double &SOG, unsigned long &DaysSince1970, double &Variation, time_t *DateTime) {
+  return ParseRMC_nc(NMEA0183Msg,GPSTime,Status,Latitude,Longitude,TrueCOG,SOG,DaysSince1970,Variation,DateTime);
+}
+
+bool NMEA0183ParseRMC_nc(const tNMEA0183MsgView &NMEA0183Msg, double &GPSTime, char &Status, double &Latitude, double &Longitude, double &TrueCOG, double &SOG, unsigned long &DaysSince1970, double &Variation, time_t *DateTime) {
+  return ParseRMC_nc(NMEA0183Msg,GPSTime,Status,Latitude,Longitude,TrueCOG,SOG,DaysSince1970,Variation,DateTime);
+}
+
 //*****************************************************************************
-bool NMEA0183SetRMC(tNMEA0183Msg &NMEA0183Msg, double GPSTime, double Latitude, double Longitude,
+bool NMEA0183SetRMC(tNMEA0183MsgBase &NMEA0183Msg, double GPSTime, double Latitude, double Longitude,
                       double TrueCOG, double SOG, unsigned long DaysSince1970, double Variation,
                       char FAAModeIndicator, char NavStatus, const char *Src) {
 
@@ -420,7 +489,8 @@ bool NMEA0183SetRMC(tNMEA0183Msg &NMEA0183Msg, double GPSTime, double Latitude,
 
 //*****************************************************************************
 // $GPVTG,89.34,T,81.84,M,0.00,N,0.01,K*24
-bool NMEA0183ParseVTG_nc(const tNMEA0183Msg &NMEA0183Msg, double &TrueCOG, double &MagneticCOG, double &SOG) {
+template<class tMsg>
+static bool ParseVTG_nc(const tMsg &NMEA0183Msg, double &TrueCOG, double &MagneticCOG, double &SOG) {
   bool result=( NMEA0183Msg.FieldCount()>=8 );
 
   if ( result ) {
@@ -435,7 +505,15 @@ bool NMEA0183ParseVTG_nc(const tNMEA0183Msg &NMEA0183Msg, double &TrueCOG, doubl
   return result;
 }
 
-bool NMEA0183SetVTG(tNMEA0183Msg &NMEA0183Msg, double TrueCOG, double MagneticCOG, double SOG, const char *Src) {
+bool NMEA0183ParseVTG_nc(const tNMEA0183MsgBase &NMEA0183Msg, double &TrueCOG, double &MagneticCOG, double &SOG) {
+  return ParseVTG_nc(NMEA0183Msg,TrueCOG,MagneticCOG,SOG);
+}
+
+bool NMEA0183ParseVTG_nc(const tNMEA0183MsgView &NMEA0183Msg, double &TrueCOG, double &MagneticCOG, double &SOG) {
+  return ParseVTG_nc(NMEA0183Msg,TrueCOG,MagneticCOG,SOG);
+}
+
+bool NMEA0183SetVTG(tNMEA0183MsgBase &NMEA0183Msg, double TrueCOG, double MagneticCOG, double SOG, const char *Src) {
   if ( SOG!=NMEA0183DoubleNA && SOG<0 ) {
     if ( TrueCOG!=NMEA0183DoubleNA  ) TrueCOG+=pi;
     if ( MagneticCOG!=NMEA0183DoubleNA  ) MagneticCOG+=pi;
@@ -454,7 +532,8 @@ bool NMEA0183SetVTG(tNMEA0183Msg &NMEA0183Msg, double TrueCOG, double MagneticCO
 
 //*****************************************************************************
 // $VWVHW,x.x,T,x.x,M,x.x,N,x.x,K*24
-bool NMEA0183ParseVHW_nc(const tNMEA0183Msg &NMEA0183Msg, double &TrueHeading, double &MagneticHeading, double &SOW) {
+template<class tMsg>
+static bool ParseVHW_nc(const tMsg &NMEA0183Msg, double &TrueHeading, double &MagneticHeading, double &SOW) {
   bool result=( NMEA0183Msg.FieldCount()>=8 );
 
   if ( result ) {
@@ -470,9 +549,17 @@ bool NMEA0183ParseVHW_nc(const tNMEA0183Msg &NMEA0183Msg, double &TrueHeading, d
   return result;
 }
 
+bool NMEA0183ParseVHW_nc(const tNMEA0183MsgBase &NMEA0183Msg, double &TrueHeading, double &MagneticHeading, double &SOW) {
+  return ParseVHW_nc(NMEA0183Msg,TrueHeading,MagneticHeading,SOW);
+}
+
+bool NMEA0183ParseVHW_nc(const tNMEA0183MsgView &NMEA0183Msg, double &TrueHeading, double &MagneticHeading, double &SOW) {
+  return ParseVHW_nc(NMEA0183Msg,TrueHeading,MagneticHeading,SOW);
+}
+
 //*****************************************************************************
 // VHW - Water speed and heading
-bool NMEA0183SetVHW(tNMEA0183Msg &NMEA0183Msg, double TrueHeading, double MagneticHeading, double BoatSpeed, const char *Src) {
+bool NMEA0183SetVHW(tNMEA0183MsgBase &NMEA0183Msg, double TrueHeading, double MagneticHeading, double BoatSpeed, const char *Src) {
   if ( !NMEA0183Msg.Init("VHW",Src) ) return false;
   if ( !NMEA0183Msg.AddDoubleField(TrueHeading,radToDeg,tNMEA0183Msg::DefDoubleFormat,"T") ) return false;
   if ( !NMEA0183Msg.AddDoubleField(MagneticHeading,radToDeg,tNMEA0183Msg::DefDoubleFormat,"M") ) return false;
@@ -534,7 +621,8 @@ bool NMEA0183BuildVTG(char* msg, const char Src[], double TrueCOG, double Magnet
 
 //*****************************************************************************
 // $HEROT,4.71,A*1B
-bool NMEA0183ParseROT_nc(const tNMEA0183Msg &NMEA0183Msg,double &RateOfTurn) {
+template<class tMsg>
+static bool ParseROT_nc(const tMsg &NMEA0183Msg,double &RateOfTurn) {
   bool result=( NMEA0183Msg.FieldCount()>=2 );
   if ( result ) {
     RateOfTurn=NMEA0183GetDouble(NMEA0183Msg.Field(0),degToRad);
@@ -543,7 +631,15 @@ bool NMEA0183ParseROT_nc(const tNMEA0183Msg &NMEA0183Msg,double &RateOfTurn) {
   return result;
 }
 
-bool NMEA0183SetROT(tNMEA0183Msg &NMEA0183Msg, double RateOfTurn, const char *Src) {
+bool NMEA0183ParseROT_nc(const tNMEA0183MsgBase &NMEA0183Msg, double &RateOfTurn) {
+  return ParseROT_nc(NMEA0183Msg,RateOfTurn);
+}
+
+bool NMEA0183ParseROT_nc(const tNMEA0183MsgView &NMEA0183Msg, double &RateOfTurn) {
+  return ParseROT_nc(NMEA0183Msg,RateOfTurn);
+}
+
+bool NMEA0183SetROT(tNMEA0183MsgBase &NMEA0183Msg, double RateOfTurn, const char *Src) {
   if ( !NMEA0183Msg.Init("ROT",Src) ) return false;
   if ( !NMEA0183Msg.AddDoubleField(RateOfTurn,radToDeg,tNMEA0183Msg::DefDoubleFormat,"A") ) return false;
   return true;
@@ -551,7 +647,8 @@ bool NMEA0183SetROT(tNMEA0183Msg &NMEA0183Msg, double RateOfTurn, const char *Sr
 
 //*****************************************************************************
 // $HEHDT,244.71,T*1B
-bool NMEA0183ParseHDT_nc(const tNMEA0183Msg &NMEA0183Msg,double &TrueHeading) {
+template<class tMsg>
+static bool ParseHDT_nc(const tMsg &NMEA0183Msg,double &TrueHeading) {
   bool result=( NMEA0183Msg.FieldCount()>=2 );
   if ( result ) {
     TrueHeading=NMEA0183GetDouble(NMEA0183Msg.Field(0),degToRad);
@@ -560,7 +657,15 @@ bool NMEA0183ParseHDT_nc(const tNMEA0183Msg &NMEA0183Msg,double &TrueHeading) {
   return result;
 }
 
-bool NMEA0183SetHDT(tNMEA0183Msg &NMEA0183Msg, double Heading, const char *Src) {
+bool NMEA0183ParseHDT_nc(const tNMEA0183MsgBase &NMEA0183Msg, double &TrueHeading) {
+  return ParseHDT_nc(NMEA0183Msg,TrueHeading);
+}
+
+bool NMEA0183ParseHDT_nc(const tNMEA0183MsgView &NMEA0183Msg, double &TrueHeading) {
+  return ParseHDT_nc(NMEA0183Msg,TrueHeading);
+}
+
+bool NMEA0183SetHDT(tNMEA0183MsgBase &NMEA0183Msg, double Heading, const char *Src) {
   if ( !NMEA0183Msg.Init("HDT",Src) ) return false;
   if ( !NMEA0183Msg.AddDoubleField(Heading,radToDeg) ) return false;
   if ( !NMEA0183Msg.AddStrField("T") ) return false;
@@ -569,7 +674,8 @@ bool NMEA0183SetHDT(tNMEA0183Msg &NMEA0183Msg, double Heading, const char *Src)
 
 //*****************************************************************************
 // $HEHDM,244.71,M*1B
-bool NMEA0183ParseHDM_nc(const tNMEA0183Msg &NMEA0183Msg,double &MagneticHeading) {
+template<class tMsg>
+static bool ParseHDM_nc(const tMsg &NMEA0183Msg,double &MagneticHeading) {
   bool result=( NMEA0183Msg.FieldCount()>=2 );
   if ( result ) {
     MagneticHeading=NMEA0183GetDouble(NMEA0183Msg.Field(0),degToRad);
@@ -578,7 +684,15 @@ bool NMEA0183ParseHDM_nc(const tNMEA0183Msg &NMEA0183Msg,double &MagneticHeading
   return result;
 }
 
-bool NMEA0183SetHDM(tNMEA0183Msg &NMEA0183Msg, double Heading, const char *Src) {
+bool NMEA0183ParseHDM_nc(const tNMEA0183MsgBase &NMEA0183Msg, double &MagneticHeading) {
+  return ParseHDM_nc(NMEA0183Msg,MagneticHeading);
+}
+
+bool NMEA0183ParseHDM_nc(const tNMEA0183MsgView &NMEA0183Msg, double &MagneticHeading) {
+  return ParseHDM_nc(NMEA0183Msg,MagneticHeading);
+}
+
+bool NMEA0183SetHDM(tNMEA0183MsgBase &NMEA0183Msg, double Heading, const char *Src) {
   if ( !NMEA0183Msg.Init("HDM",Src) ) return false;
   if ( !NMEA0183Msg.AddDoubleField(Heading,radToDeg) ) return false;
   if ( !NMEA0183Msg.AddStrField("M") ) return false;
@@ -586,7 +700,7 @@ bool NMEA0183SetHDM(tNMEA0183Msg &NMEA0183Msg, double Heading, const char *Src)
 }
 
 //*****************************************************************************
-bool NMEA0183SetHDG(tNMEA0183Msg &NMEA0183Msg, double Heading, double Deviation, double Variation, const char *Src) {
+bool NMEA0183SetHDG(tNMEA0183MsgBase &NMEA0183Msg, double Heading, double Deviation, double Variation, const char *Src) {
   if ( !NMEA0183Msg.Init("HDG",Src) ) return false;
   if ( !NMEA0183Msg.AddDoubleField(Heading,radToDeg) ) return false;
   // Set deviation, if value is valid
@@ -625,7 +739,8 @@ bool NMEA0183SetHDG(tNMEA0183Msg &NMEA0183Msg, double Heading, double Deviation,
 // Radio Channel Code (B): A/B or 1/2
 // Payload - 6bit encoded
 // Fillbits (0)
-bool NMEA0183ParseVDM_nc(const tNMEA0183Msg &NMEA0183Msg,
+template<class tMsg>
+static bool ParseVDM_nc(const tMsg &NMEA0183Msg,
 			uint8_t &pkgCnt, uint8_t &pkgNmb,
 			unsigned int &seqMessageId, char &channel,
 			unsigned int &length, char *bitstream,
@@ -650,7 +765,15 @@ bool NMEA0183ParseVDM_nc(const tNMEA0183Msg &NMEA0183Msg,
 
   return result;
 }
-bool NMEA0183SetVDM(tNMEA0183Msg &NMEA0183Msg, char *channel, char *bitstream, const char *Src) {
+
+bool NMEA0183ParseVDM_nc(const tNMEA0183MsgBase &NMEA0183Msg, uint8_t &pkgCnt, uint8_t &pkgNmb, unsigned int &seqMessageId, char &channel, unsigned int &length, char *bitstream, unsigned int &fillBits) {
+  return ParseVDM_nc(NMEA0183Msg,pkgCnt,pkgNmb,seqMessageId,channel,length,bitstream,fillBits);
+}
+
+bool NMEA0183ParseVDM_nc(const tNMEA0183MsgView &NMEA0183Msg, uint8_t &pkgCnt, uint8_t &pkgNmb, unsigned int &seqMessageId, char &channel, unsigned int &length, char *bitstream, unsigned int &fillBits) {
+  return ParseVDM_nc(NMEA0183Msg,pkgCnt,pkgNmb,seqMessageId,channel,length,bitstream,fillBits);
+}
+bool NMEA0183SetVDM(tNMEA0183MsgBase &NMEA0183Msg, char *channel, char *bitstream, const char *Src) {
 	if ( !NMEA0183Msg.Init("VDM",Src, '!') ) return false;    // field 1: packet identifier,  VDM
 	if ( !NMEA0183Msg.AddUInt32Field(1) ) return false;  // field 2: fragment count
 	if ( !NMEA0183Msg.AddUInt32Field(1) ) return false;  // field 3: fragment number
@@ -661,7 +784,7 @@ bool NMEA0183SetVDM(tNMEA0183Msg &NMEA0183Msg, char *channel, char *bitstream, c
   
   return true;
 }
-bool NMEA0183SetVDM(tNMEA0183Msg &NMEA0183Msg, char *channel, char *bitstream, uint32_t count, uint32_t number, uint32_t id, uint32_t fillbits,  const char *Src) {
+bool NMEA0183SetVDM(tNMEA0183MsgBase &NMEA0183Msg, char *channel, char *bitstream, uint32_t count, uint32_t number, uint32_t id, uint32_t fillbits,  const char *Src) {
 	if ( !NMEA0183Msg.Init("VDM",Src, '!') ) return false;    // field 1: packet identifier,  VDM
 	if ( !NMEA0183Msg.AddUInt32Field(count) ) return false;  // field 2: fragment count
 	if ( !NMEA0183Msg.AddUInt32Field(number) ) return false;  // field 3: fragment number
@@ -676,7 +799,7 @@ bool NMEA0183SetVDM(tNMEA0183Msg &NMEA0183Msg, char *channel, char *bitstream, u
   
   return true;
 }
-bool NMEA0183SetVDO(tNMEA0183Msg &NMEA0183Msg, char *channel, char *bitstream, const char *Src) {
+bool NMEA0183SetVDO(tNMEA0183MsgBase &NMEA0183Msg, char *channel, char *bitstream, const char *Src) {
 	if ( !NMEA0183Msg.Init("VDO",Src, '!') ) return false;    // field 1: packet identifier,  VDM
 	if ( !NMEA0183Msg.AddUInt32Field(1) ) return false;  // field 2: fragment count
 	if ( !NMEA0183Msg.AddUInt32Field(1) ) return false;  // field 3: fragment number
@@ -687,7 +810,7 @@ bool NMEA0183SetVDO(tNMEA0183Msg &NMEA0183Msg, char *channel, char *bitstream, c
   
   return true;
 }
-bool NMEA0183SetVDO(tNMEA0183Msg &NMEA0183Msg, char *channel, char *bitstream, uint32_t count, uint32_t number, uint32_t id, uint32_t fillbits,  const char *Src) {
+bool NMEA0183SetVDO(tNMEA0183MsgBase &NMEA0183Msg, char *channel, char *bitstream, uint32_t count, uint32_t number, uint32_t id, uint32_t fillbits,  const char *Src) {
 	if ( !NMEA0183Msg.Init("VDO",Src, '!') ) return false;    // field 1: packet identifier,  VDM
 	if ( !NMEA0183Msg.AddUInt32Field(count) ) return false;  // field 2: fragment count
 	if ( !NMEA0183Msg.AddUInt32Field(number) ) return false;  // field 3: fragment number
@@ -706,7 +829,8 @@ bool NMEA0183SetVDO(tNMEA0183Msg &NMEA0183Msg, char *channel, char *bitstream, u
 
 //*****************************************************************************
 //$GPRTE,2,1,c,0,W3IWI,DRIVWY,32CEDR,32-29,32BKLD,32-I95,32-US1,BW-32,BW-198*69
-bool NMEA0183ParseRTE_nc(const tNMEA0183Msg &NMEA0183Msg, tRTE &tRTE) {
+template<class tMsg>
+static bool ParseRTE_nc(const tMsg &NMEA0183Msg, tRTE &tRTE) {
 
     bool result=( NMEA0183Msg.FieldCount()>=4);
 
@@ -721,8 +845,9 @@ bool NMEA0183ParseRTE_nc(const tNMEA0183Msg &NMEA0183Msg, tRTE &tRTE) {
 	 byte wpIndex=0;
 	 //Copy WP's into 1D-array separated by null terminator.
 	 for (byte i=4; i < NMEA0183Msg.FieldCount(); i++) {
-		for (byte j=0; j < NMEA0183Msg.FieldLen(i); j++) {
-			tRTE._wp[wpIndex++] = NMEA0183Msg.Field(i)[j];
+		tNMEA0183Field wp=NMEA0183Msg.FieldView(i);
+		for (byte j=0; j < wp.Len; j++) {
+			tRTE._wp[wpIndex++] = wp.Data[j];
 		}
 		tRTE._wp[wpIndex++] = 0;
 	 }
@@ -730,42 +855,66 @@ bool NMEA0183ParseRTE_nc(const tNMEA0183Msg &NMEA0183Msg, tRTE &tRTE) {
     return result;
 }
 
+bool NMEA0183ParseRTE_nc(const tNMEA0183MsgBase &NMEA0183Msg, tRTE &tRTE) {
+  return ParseRTE_nc(NMEA0183Msg,tRTE);
+}
+
+bool NMEA0183ParseRTE_nc(const tNMEA0183MsgView &NMEA0183Msg, tRTE &tRTE) {
+  return ParseRTE_nc(NMEA0183Msg,tRTE);
+}
+
 //*****************************************************************************
 //$GPWPL,5208.700,N,00438.600,E,MOLENB*4D
-bool NMEA0183ParseWPL_nc(const tNMEA0183Msg &NMEA0183Msg, tWPL &wpl) {
+template<class tMsg>
+static bool ParseWPL_nc(const tMsg &NMEA0183Msg, tWPL &wpl) {
 
     bool result=( NMEA0183Msg.FieldCount()>=5);
 
     if ( result ) {
       wpl.latitude = LatLonToDouble(NMEA0183Msg.Field(0),NMEA0183Msg.Field(1)[0]);
       wpl.longitude = LatLonToDouble(NMEA0183Msg.Field(2),NMEA0183Msg.Field(3)[0]);
-      strncpy(wpl.name,NMEA0183Msg.Field(4),sizeof(wpl.name)/sizeof(char));
-      wpl.name[sizeof(wpl.name)/sizeof(char)-1]='\0';
+      CopyField(NMEA0183Msg,4,wpl.name,sizeof(wpl.name));
 	  }
     return result;
 }
 
+bool NMEA0183ParseWPL_nc(const tNMEA0183MsgBase &NMEA0183Msg, tWPL &wpl) {
+  return ParseWPL_nc(NMEA0183Msg,wpl);
+}
+
+bool NMEA0183ParseWPL_nc(const tNMEA0183MsgView &NMEA0183Msg, tWPL &wpl) {
+  return ParseWPL_nc(NMEA0183Msg,wpl);
+}
+
 //*****************************************************************************
 //$GPBOD,001.1,T,003.4,M,WETERB,WOUBRG*49
-bool NMEA0183ParseBOD_nc(const tNMEA0183Msg &NMEA0183Msg, tBOD &bod) {
+template<class tMsg>
+static bool ParseBOD_nc(const tMsg &NMEA0183Msg, tBOD &bod) {
 
     bool result=( NMEA0183Msg.FieldCount()>=6);
 
     if ( result ) {
       bod.trueBearing = atof(NMEA0183Msg.Field(0))*degToRad;
       bod.magBearing = atof(NMEA0183Msg.Field(2))*degToRad;
-      strncpy(bod.destID,NMEA0183Msg.Field(4),sizeof(bod.destID)/sizeof(char));
-      bod.destID[sizeof(bod.destID)/sizeof(char)-1]='\0';
-      strncpy(bod.originID,NMEA0183Msg.Field(5),sizeof(bod.originID)/sizeof(char));
-      bod.originID[sizeof(bod.originID)/sizeof(char)-1]='\0';
+      CopyField(NMEA0183Msg,4,bod.destID,sizeof(bod.destID));
+      CopyField(NMEA0183Msg,5,bod.originID,sizeof(bod.originID));
 	  }
     return result;
 }
 
+bool NMEA0183ParseBOD_nc(const tNMEA0183MsgBase &NMEA0183Msg, tBOD &bod) {
+  return ParseBOD_nc(NMEA0183Msg,bod);
+}
+
+bool NMEA0183ParseBOD_nc(const tNMEA0183MsgView &NMEA0183Msg, tBOD &bod) {
+  return ParseBOD_nc(NMEA0183Msg,bod);
+}
+
 //*****************************************************************************
 // MWV - Wind Speed and Angle
 //$IIMWV,120.1,R,9.5,M,A,a*hh
-bool NMEA0183ParseMWV_nc(const tNMEA0183Msg &NMEA0183Msg,double &WindAngle, tNMEA0183WindReference &Reference, double &WindSpeed) {
+template<class tMsg>
+static bool ParseMWV_nc(const tMsg &NMEA0183Msg,double &WindAngle, tNMEA0183WindReference &Reference, double &WindSpeed) {
   bool result=( NMEA0183Msg.FieldCount()>=4 );
 
   if ( result ) {
@@ -787,7 +936,15 @@ bool NMEA0183ParseMWV_nc(const tNMEA0183Msg &NMEA0183Msg,double &WindAngle, tNME
   return result;
 }
 
-bool NMEA0183SetMWV(tNMEA0183Msg &NMEA0183Msg, double WindAngle, tNMEA0183WindReference Reference, double WindSpeed, const char *Src) {
+bool NMEA0183ParseMWV_nc(const tNMEA0183MsgBase &NMEA0183Msg, double &WindAngle, tNMEA0183WindReference &Reference, double &WindSpeed) {
+  return ParseMWV_nc(NMEA0183Msg,WindAngle,Reference,WindSpeed);
+}
+
+bool NMEA0183ParseMWV_nc(const tNMEA0183MsgView &NMEA0183Msg, double &WindAngle, tNMEA0183WindReference &Reference, double &WindSpeed) {
+  return ParseMWV_nc(NMEA0183Msg,WindAngle,Reference,WindSpeed);
+}
+
+bool NMEA0183SetMWV(tNMEA0183MsgBase &NMEA0183Msg, double WindAngle, tNMEA0183WindReference Reference, double WindSpeed, const char *Src) {
   if ( !NMEA0183Msg.Init("MWV",Src) ) return false;
   if ( !NMEA0183Msg.AddDoubleField(WindAngle) ) return false;
   if ( !NMEA0183Msg.AddStrField(Reference==NMEA0183Wind_True?"T":"R") ) return false;
@@ -800,7 +957,7 @@ bool NMEA0183SetMWV(tNMEA0183Msg &NMEA0183Msg, double WindAngle, tNMEA0183WindRe
 //*****************************************************************************
 // GSV - GPS sattellites in view
 //$GPGSV,2,1,08,01,40,083,46,02,17,308,41,12,07,344,39,14,22,228,45*75
-bool NMEA0183SetGSV(tNMEA0183Msg &NMEA0183Msg, uint32_t totalMSG, uint32_t thisMSG, uint32_t SatelliteCount, 
+bool NMEA0183SetGSV(tNMEA0183MsgBase &NMEA0183Msg, uint32_t totalMSG, uint32_t thisMSG, uint32_t SatelliteCount, 
 					uint32_t PRN1, uint32_t Elevation1, uint32_t Azimuth1, uint32_t SNR1,
 					uint32_t PRN2, uint32_t Elevation2, uint32_t Azimuth2, uint32_t SNR2,
 					uint32_t PRN3, uint32_t Elevation3, uint32_t Azimuth3, uint32_t SNR3,
@@ -829,7 +986,8 @@ bool NMEA0183SetGSV(tNMEA0183Msg &NMEA0183Msg, uint32_t totalMSG, uint32_t thisM
 	return true; 
 }
 	  
-bool NMEA0183ParseGSV_nc(const tNMEA0183Msg &NMEA0183Msg, int &totalMSG, int &thisMSG, int &SatelliteCount,
+template<class tMsg>
+static bool ParseGSV_nc(const tMsg &NMEA0183Msg, int &totalMSG, int &thisMSG, int &SatelliteCount,
                         struct tGSV &Msg1,
                         struct tGSV &Msg2,
                         struct tGSV &Msg3,
@@ -862,9 +1020,18 @@ bool NMEA0183ParseGSV_nc(const tNMEA0183Msg &NMEA0183Msg, int &totalMSG, int &th
   return result;
 }
 
+bool NMEA0183ParseGSV_nc(const tNMEA0183MsgBase &NMEA0183Msg, int &totalMSG, int &thisMSG, int &SatelliteCount, struct tGSV &Msg1, struct tGSV &Msg2, struct tGSV &Msg3, struct tGSV &Msg4) {
+  return ParseGSV_nc(NMEA0183Msg,totalMSG,thisMSG,SatelliteCount,Msg1,Msg2,Msg3,Msg4);
+}
+
+bool NMEA0183ParseGSV_nc(const tNMEA0183MsgView &NMEA0183Msg, int &totalMSG, int &thisMSG, int &SatelliteCount, struct tGSV &Msg1, struct tGSV &Msg2, struct tGSV &Msg3, struct tGSV &Msg4) {
+  return ParseGSV_nc(NMEA0183Msg,totalMSG,thisMSG,SatelliteCount,Msg1,Msg2,Msg3,Msg4);
+}
+
 //*****************************************************************************
 // $GPZDA,160012.71,11,03,2004,-1,00*7D
-bool NMEA0183ParseZDA(const tNMEA0183Msg &NMEA0183Msg, double &GPSTime, int &GPSDay, int &GPSMonth, int &GPSYear,
+template<class tMsg>
+static bool ParseZDA(const tMsg &NMEA0183Msg, double &GPSTime, int &GPSDay, int &GPSMonth, int &GPSYear,
                       int &LZD, int &LZMD) {
   bool result=( NMEA0183Msg.FieldCount()>=6 );
 
@@ -880,7 +1047,16 @@ bool NMEA0183ParseZDA(const tNMEA0183Msg &NMEA0183Msg, double &GPSTime, int &GPS
   return result;
 }
 
-bool NMEA0183ParseZDA(const tNMEA0183Msg &NMEA0183Msg, time_t &DateTime, long &Timezone) {
+bool NMEA0183ParseZDA(const tNMEA0183MsgBase &NMEA0183Msg, double &GPSTime, int &GPSDay, int &GPSMonth, int &GPSYear, int &LZD, int &LZMD) {
+  return ParseZDA(NMEA0183Msg,GPSTime,GPSDay,GPSMonth,GPSYear,LZD,LZMD);
+}
+
+bool NMEA0183ParseZDA(const tNMEA0183MsgView &NMEA0183Msg, double &GPSTime, int &GPSDay, int &GPSMonth, int &GPSYear, int &LZD, int &LZMD) {
+  return ParseZDA(NMEA0183Msg,GPSTime,GPSDay,GPSMonth,GPSYear,LZD,LZMD);
+}
+
+template<class tMsg>
+static bool ParseZDA(const tMsg &NMEA0183Msg, time_t &DateTime, long &Timezone) {
 
   bool result=( NMEA0183Msg.FieldCount()>=6 );
 
@@ -904,7 +1080,15 @@ bool NMEA0183ParseZDA(const tNMEA0183Msg &NMEA0183Msg, time_t &DateTime, long &T
   return result;
 }
 
-bool NMEA0183SetZDA(tNMEA0183Msg& NMEA0183Msg, double GPSTime, int GPSDay, int GPSMonth, int GPSYear, int LZD, int LZMD, const char* Src)
+bool NMEA0183ParseZDA(const tNMEA0183MsgBase &NMEA0183Msg, time_t &DateTime, long &Timezone) {
+  return ParseZDA(NMEA0183Msg,DateTime,Timezone);
+}
+
+bool NMEA0183ParseZDA(const tNMEA0183MsgView &NMEA0183Msg, time_t &DateTime, long &Timezone) {
+  return ParseZDA(NMEA0183Msg,DateTime,Timezone);
+}
+
+bool NMEA0183SetZDA(tNMEA0183MsgBase& NMEA0183Msg, double GPSTime, int GPSDay, int GPSMonth, int GPSYear, int LZD, int LZMD, const char* Src)
 {
     char tmp[10];
     if (!NMEA0183Msg.Init("ZDA", Src)) return false;
@@ -922,7 +1106,8 @@ bool NMEA0183SetZDA(tNMEA0183Msg& NMEA0183Msg, double GPSTime, int GPSDay, int G
 }
 
 //*****************************************************************************
-bool NMEA0183ParseAPB_nc(const tNMEA0183Msg &NMEA0183Msg, tAPB &APB) {
+template<class tMsg>
+static bool ParseAPB_nc(const tMsg &NMEA0183Msg, tAPB &APB) {
 
   bool result=( NMEA0183Msg.FieldCount()>=14 );
 
@@ -945,8 +1130,7 @@ bool NMEA0183ParseAPB_nc(const tNMEA0183Msg &NMEA0183Msg, tAPB &APB) {
     APB.perpendicularPassed=NMEA0183Msg.Field(6)[0];
     APB.botw=NMEA0183GetDouble(NMEA0183Msg.Field(7))*degToRad;
     APB.botwMode=NMEA0183Msg.Field(8)[0];
-    strncpy(APB.destID,NMEA0183Msg.Field(9),sizeof(APB.destID)/sizeof(char));
-    APB.destID[sizeof(APB.destID)/sizeof(char)-1]='\0';
+    CopyField(NMEA0183Msg,9,APB.destID,sizeof(APB.destID));
     APB.btw=NMEA0183GetDouble(NMEA0183Msg.Field(10))*degToRad;
     APB.btwMode=NMEA0183Msg.Field(11)[0];
     APB.headingToSteer=NMEA0183GetDouble(NMEA0183Msg.Field(12))*degToRad;
@@ -957,13 +1141,21 @@ bool NMEA0183ParseAPB_nc(const tNMEA0183Msg &NMEA0183Msg, tAPB &APB) {
 
 }
 
-static bool AddDoubleFieldWithSign(tNMEA0183Msg& NMEA0183Msg, const double v)
+bool NMEA0183ParseAPB_nc(const tNMEA0183MsgBase &NMEA0183Msg, tAPB &APB) {
+  return ParseAPB_nc(NMEA0183Msg,APB);
+}
+
+bool NMEA0183ParseAPB_nc(const tNMEA0183MsgView &NMEA0183Msg, tAPB &APB) {
+  return ParseAPB_nc(NMEA0183Msg,APB);
+}
+
+static bool AddDoubleFieldWithSign(tNMEA0183MsgBase& NMEA0183Msg, const double v)
 {
     return NMEA0183Msg.AddDoubleField(v, 1, (v>=0 ? "+%.2f" : "%.2f"));
 }
 
 //*****************************************************************************
-bool NMEA0183SetSHR(tNMEA0183Msg& NMEA0183Msg, double GPSTime, const double HeadingRad, const double RollRad, const double PitchRad, double HeaveM, double RollAccuracyRad, double PitchAccuracyRad, double HeadingAccuracyRad, int GPSQualityIndicator, int INSStatusFlag, const char* Source)
+bool NMEA0183SetSHR(tNMEA0183MsgBase& NMEA0183Msg, double GPSTime, const double HeadingRad, const double RollRad, const double PitchRad, double HeaveM, double RollAccuracyRad, double PitchAccuracyRad, double HeadingAccuracyRad, int GPSQualityIndicator, int INSStatusFlag, const char* Source)
 {
   if (!NMEA0183Msg.Init("SHR", Source)) return false;
   if (!NMEA0183Msg.AddTimeField(GPSTime)) return false;
@@ -982,7 +1174,8 @@ bool NMEA0183SetSHR(tNMEA0183Msg& NMEA0183Msg, double GPSTime, const double Head
 
 //*****************************************************************************
 // $GPMTW,11.2,C*24
-bool NMEA0183ParseMTW_nc(const tNMEA0183Msg &NMEA0183Msg, double &Watertemp)
+template<class tMsg>
+static bool ParseMTW_nc(const tMsg &NMEA0183Msg, double &Watertemp)
 {
   bool result=( NMEA0183Msg.FieldCount()>=2 );
 
@@ -992,7 +1185,15 @@ bool NMEA0183ParseMTW_nc(const tNMEA0183Msg &NMEA0183Msg, double &Watertemp)
   return result;
 }
 
-bool NMEA0183SetMTW(tNMEA0183Msg &NMEA0183Msg, double WaterTemp, const char *Src) {
+bool NMEA0183ParseMTW_nc(const tNMEA0183MsgBase &NMEA0183Msg, double &Watertemp) {
+  return ParseMTW_nc(NMEA0183Msg,Watertemp);
+}
+
+bool NMEA0183ParseMTW_nc(const tNMEA0183MsgView &NMEA0183Msg, double &Watertemp) {
+  return ParseMTW_nc(NMEA0183Msg,Watertemp);
+}
+
+bool NMEA0183SetMTW(tNMEA0183MsgBase &NMEA0183Msg, double WaterTemp, const char *Src) {
   if ( !NMEA0183Msg.Init("MTW",Src)) return false;
   if ( !NMEA0183Msg.AddDoubleField(WaterTemp)) return false;
   if ( !NMEA0183Msg.AddStrField("C")) return false;
@@ -27,6 +27,7 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <stdio.h>
 #include <time.h>
 #include "NMEA0183Msg.h"
+#include "NMEA0183MsgView.h"
 
 #ifndef Arduino
 typedef uint8_t byte;
@@ -228,113 +229,132 @@ double NMEA0183GPTimeToSeconds(const char *data);
 time_t NMEA0183GPSDateTimetotime_t(const char *dateStr, const char *timeStr, time_t defDate=NMEA0183time_tNA);
 
 //*****************************************************************************
-bool NMEA0183SetDBK(tNMEA0183Msg &NMEA0183Msg, double Depth, const char *Src="II");
+bool NMEA0183SetDBK(tNMEA0183MsgBase &NMEA0183Msg, double Depth, const char *Src="II");
 
 //*****************************************************************************
-bool NMEA0183SetDBS(tNMEA0183Msg &NMEA0183Msg, double Depth, const char *Src="II");
+bool NMEA0183SetDBS(tNMEA0183MsgBase &NMEA0183Msg, double Depth, const char *Src="II");
 
 //*****************************************************************************
-bool NMEA0183SetDBT(tNMEA0183Msg &NMEA0183Msg, double Depth, const char *Src="II");
+bool NMEA0183SetDBT(tNMEA0183MsgBase &NMEA0183Msg, double Depth, const char *Src="II");
 
 //*****************************************************************************
 // Set message to DBK/DBS/DBT automatically according to Offset
-bool NMEA0183SetDBx(tNMEA0183Msg &NMEA0183Msg, double DepthBelowTransducer, double Offset, const char *Src="II");
+bool NMEA0183SetDBx(tNMEA0183MsgBase &NMEA0183Msg, double DepthBelowTransducer, double Offset, const char *Src="II");
 
 
 //*****************************************************************************
-bool NMEA0183ParseDPT_nc(const tNMEA0183Msg &NMEA0183Msg,  double &DepthBelowTransducer, double &Offset, double &Range );
-inline bool NMEA0183ParseDPT(const tNMEA0183Msg &NMEA0183Msg,  double &DepthBelowTransducer, double &Offset, double &Range ) {
-  return (NMEA0183Msg.IsMessageCode("DPT")
+bool NMEA0183ParseDPT_nc(const tNMEA0183MsgBase &NMEA0183Msg,  double &DepthBelowTransducer, double &Offset, double &Range );
+bool NMEA0183ParseDPT_nc(const tNMEA0183MsgView &NMEA0183Msg,  double &DepthBelowTransducer, double &Offset, double &Range );
+template<class tMsg>
+inline bool NMEA0183ParseDPT(const tMsg &NMEA0183Msg,  double &DepthBelowTransducer, double &Offset, double &Range ) {
+  return (NMEA0183Msg.IsMessageCode(NMEA0183Code("DPT"))
             ?NMEA0183ParseDPT_nc(NMEA0183Msg,DepthBelowTransducer, Offset, Range )
             :false);
 }
 
-bool NMEA0183ParseDPT_nc(const tNMEA0183Msg &NMEA0183Msg,  double &DepthBelowTransducer, double &Offset );
-inline bool NMEA0183ParseDPT(const tNMEA0183Msg &NMEA0183Msg,  double &DepthBelowTransducer, double &Offset ) {
-  return (NMEA0183Msg.IsMessageCode("DPT")
+bool NMEA0183ParseDPT_nc(const tNMEA0183MsgBase &NMEA0183Msg,  double &DepthBelowTransducer, double &Offset );
+bool NMEA0183ParseDPT_nc(const tNMEA0183MsgView &NMEA0183Msg,  double &DepthBelowTransducer, double &Offset );
+template<class tMsg>
+inline bool NMEA0183ParseDPT(const tMsg &NMEA0183Msg,  double &DepthBelowTransducer, double &Offset ) {
+  return (NMEA0183Msg.IsMessageCode(NMEA0183Code("DPT"))
             ?NMEA0183ParseDPT_nc(NMEA0183Msg,DepthBelowTransducer, Offset )
             :false);
 }
 
-bool NMEA0183SetDPT(tNMEA0183Msg &NMEA0183Msg, double DepthBelowTransducer, double Offset, double Range, const char *Src="II", const char *DepthFormat=tNMEA0183Msg::DefDoubleFormat);
+bool NMEA0183SetDPT(tNMEA0183MsgBase &NMEA0183Msg, double DepthBelowTransducer, double Offset, double Range, const char *Src="II", const char *DepthFormat=tNMEA0183Msg::DefDoubleFormat);
 
-bool NMEA0183SetDPT(tNMEA0183Msg &NMEA0183Msg, double DepthBelowTransducer, double Offset, const char *Src="II", const char *DepthFormat=tNMEA0183Msg::DefDoubleFormat);
+bool NMEA0183SetDPT(tNMEA0183MsgBase &NMEA0183Msg, double DepthBelowTransducer, double Offset, const char *Src="II", const char *DepthFormat=tNMEA0183Msg::DefDoubleFormat);
 
 
 //*****************************************************************************
-bool NMEA0183ParseGGA_nc(const tNMEA0183Msg &NMEA0183Msg, double &GPSTime, double &Latitude, double &Longitude,
+bool NMEA0183ParseGGA_nc(const tNMEA0183MsgBase &NMEA0183Msg, double &GPSTime, double &Latitude, double &Longitude,
+                      int &GPSQualityIndicator, int &SatelliteCount, double &HDOP, double &Altitude, double &GeoidalSeparation,
+                      double &DGPSAge, int &DGPSReferenceStationID);
+bool NMEA0183ParseGGA_nc(const tNMEA0183MsgView &NMEA0183Msg, double &GPSTime, double &Latitude, double &Longitude,
                       int &GPSQualityIndicator, int &SatelliteCount, double &HDOP, double &Altitude, double &GeoidalSeparation,
                       double &DGPSAge, int &DGPSReferenceStationID);
 
-inline bool NMEA0183ParseGGA(const tNMEA0183Msg &NMEA0183Msg, double &GPSTime, double &Latitude, double &Longitude,
+template<class tMsg>
+inline bool NMEA0183ParseGGA(const tMsg &NMEA0183Msg, double &GPSTime, double &Latitude, double &Longitude,
                       int &GPSQualityIndicator, int &SatelliteCount, double &HDOP, double &Altitude, double &GeoidalSeparation,
                       double &DGPSAge, int &DGPSReferenceStationID) {
-  return (NMEA0183Msg.IsMessageCode("GGA")
+  return (NMEA0183Msg.IsMessageCode(NMEA0183Code("GGA"))
             ?NMEA0183ParseGGA_nc(NMEA0183Msg,GPSTime,Latitude,Longitude,GPSQualityIndicator,SatelliteCount,HDOP,Altitude,GeoidalSeparation,DGPSAge,DGPSReferenceStationID)
             :false);
 }
 
-inline bool NMEA0183ParseGGA(const tNMEA0183Msg &NMEA0183Msg, tGGA &gga) {
+template<class tMsg>
+inline bool NMEA0183ParseGGA(const tMsg &NMEA0183Msg, tGGA &gga) {
 
 	return NMEA0183ParseGGA(NMEA0183Msg,gga.GPSTime,gga.latitude,gga.longitude,gga.GPSQualityIndicator,
 										gga.satelliteCount,gga.HDOP,gga.altitude,gga.geoidalSeparation,gga.DGPSAge,gga.DGPSReferenceStationID);
 }
 
 //*****************************************************************************
-bool NMEA0183SetGGA(tNMEA0183Msg &NMEA0183Msg, double GPSTime, double Latitude, double Longitude,
+bool NMEA0183SetGGA(tNMEA0183MsgBase &NMEA0183Msg, double GPSTime, double Latitude, double Longitude,
           	uint32_t GPSQualityIndicator, uint32_t SatelliteCount, double HDOP, double Altitude, double GeoidalSeparation,
 	          double DGPSAge, uint32_t DGPSReferenceStationID, const char *Src="GP");
 
 
 //*****************************************************************************
-bool NMEA0183ParseGLL_nc(const tNMEA0183Msg &NMEA0183Msg, tGLL &gll);
+bool NMEA0183ParseGLL_nc(const tNMEA0183MsgBase &NMEA0183Msg, tGLL &gll);
+bool NMEA0183ParseGLL_nc(const tNMEA0183MsgView &NMEA0183Msg, tGLL &gll);
 
-inline bool NMEA0183ParseGLL(const tNMEA0183Msg &NMEA0183Msg, tGLL &gll) {
-  return (NMEA0183Msg.IsMessageCode("GLL")
+template<class tMsg>
+inline bool NMEA0183ParseGLL(const tMsg &NMEA0183Msg, tGLL &gll) {
+  return (NMEA0183Msg.IsMessageCode(NMEA0183Code("GLL"))
             ?NMEA0183ParseGLL_nc(NMEA0183Msg,gll)
             :false);
 }
 
 //*****************************************************************************
-bool NMEA0183SetGLL(tNMEA0183Msg &NMEA0183Msg, double GPSTime, double Latitude, double Longitude, const char *Src="GP");
+bool NMEA0183SetGLL(tNMEA0183MsgBase &NMEA0183Msg, double GPSTime, double Latitude, double Longitude, const char *Src="GP");
 
 //*****************************************************************************
-bool NMEA0183ParseRMB_nc(const tNMEA0183Msg &NMEA0183Msg, tRMB &rmb);
+bool NMEA0183ParseRMB_nc(const tNMEA0183MsgBase &NMEA0183Msg, tRMB &rmb);
+bool NMEA0183ParseRMB_nc(const tNMEA0183MsgView &NMEA0183Msg, tRMB &rmb);
 
-inline bool NMEA0183ParseRMB(const tNMEA0183Msg &NMEA0183Msg, tRMB &rmb) {
-    return (NMEA0183Msg.IsMessageCode("RMB") ?
+template<class tMsg>
+inline bool NMEA0183ParseRMB(const tMsg &NMEA0183Msg, tRMB &rmb) {
+    return (NMEA0183Msg.IsMessageCode(NMEA0183Code("RMB")) ?
         NMEA0183ParseRMB_nc(NMEA0183Msg, rmb) : false);
 }
 
 //*****************************************************************************
 // RMC
-bool NMEA0183ParseRMC_nc(const tNMEA0183Msg &NMEA0183Msg, double &GPSTime, char &Status, double &Latitude, double &Longitude,
+bool NMEA0183ParseRMC_nc(const tNMEA0183MsgBase &NMEA0183Msg, double &GPSTime, char &Status, double &Latitude, double &Longitude,
+                      double &TrueCOG, double &SOG, unsigned long &DaysSince1970, double &Variation, time_t *DateTime=0);
+bool NMEA0183ParseRMC_nc(const tNMEA0183MsgView &NMEA0183Msg, double &GPSTime, char &Status, double &Latitude, double &Longitude,
                       double &TrueCOG, double &SOG, unsigned long &DaysSince1970, double &Variation, time_t *DateTime=0);
 
-inline bool NMEA0183ParseRMC_nc(const tNMEA0183Msg &NMEA0183Msg, double &GPSTime, double &Latitude, double &Longitude,
+template<class tMsg>
+inline bool NMEA0183ParseRMC_nc(const tMsg &NMEA0183Msg, double &GPSTime, double &Latitude, double &Longitude,
                       double &TrueCOG, double &SOG, unsigned long &DaysSince1970, double &Variation, time_t *DateTime=0) {
   char Status;
   return NMEA0183ParseRMC_nc(NMEA0183Msg, GPSTime, Status, Latitude, Longitude, TrueCOG, SOG, DaysSince1970, Variation, DateTime);
 }
 
-inline bool NMEA0183ParseRMC(const tNMEA0183Msg &NMEA0183Msg, double &GPSTime, char &Status, double &Latitude, double &Longitude,
+template<class tMsg>
+inline bool NMEA0183ParseRMC(const tMsg &NMEA0183Msg, double &GPSTime, char &Status, double &Latitude, double &Longitude,
                       double &TrueCOG, double &SOG, unsigned long &DaysSince1970, double &Variation, time_t *DateTime=0) {
   (void)DateTime;
-  return (NMEA0183Msg.IsMessageCode("RMC")
+  return (NMEA0183Msg.IsMessageCode(NMEA0183Code("RMC"))
             ?NMEA0183ParseRMC_nc(NMEA0183Msg, GPSTime, Status, Latitude, Longitude, TrueCOG, SOG, DaysSince1970, Variation, DateTime)
             :false);
 }
 
-inline bool NMEA0183ParseRMC(const tNMEA0183Msg &NMEA0183Msg, double &GPSTime, double &Latitude, double &Longitude,
+template<class tMsg>
+inline bool NMEA0183ParseRMC(const tMsg &NMEA0183Msg, double &GPSTime, double &Latitude, double &Longitude,
                       double &TrueCOG, double &SOG, unsigned long &DaysSince1970, double &Variation, time_t *DateTime=0) {
   (void)DateTime;
   char Status;
-  return (NMEA0183Msg.IsMessageCode("RMC")
+  return (NMEA0183Msg.IsMessageCode(NMEA0183Code("RMC"))
             ?NMEA0183ParseRMC_nc(NMEA0183Msg, GPSTime, Status, Latitude, Longitude, TrueCOG, SOG, DaysSince1970, Variation, DateTime)
             :false);
 }
 
-inline bool NMEA0183ParseRMC(const tNMEA0183Msg &NMEA0183Msg, tRMC &rmc, time_t *DateTime=0) {
+template<class tMsg>
+inline bool NMEA0183ParseRMC(const tMsg &NMEA0183Msg, tRMC &rmc, time_t *DateTime=0) {
 
 	return NMEA0183ParseRMC(NMEA0183Msg, rmc.GPSTime, rmc.status, rmc.latitude, rmc.longitude, rmc.trueCOG, rmc.SOG, rmc.daysSince1970, rmc.variation, DateTime);
 }
@@ -348,11 +368,11 @@ inline bool NMEA0183ParseRMC(const tNMEA0183Msg &NMEA0183Msg, tRMC &rmc, time_t
 //   of 0xff to omit the field
 // Note! If you provide both 0xff, fields does not exist at all. If you provide FAAModeIndicator==0xff
 // and nav status other than 0xff, FAAModeIndicator will have empty value.
-bool NMEA0183SetRMC(tNMEA0183Msg &NMEA0183Msg, double GPSTime, double Latitude, double Longitude,
+bool NMEA0183SetRMC(tNMEA0183MsgBase &NMEA0183Msg, double GPSTime, double Latitude, double Longitude,
                       double TrueCOG, double SOG, unsigned long DaysSince1970, double Variation,
                       char FAAModeIndicator, char NavStatus=0xff, const char *Src="GP");
                       
-inline bool NMEA0183SetRMC(tNMEA0183Msg &NMEA0183Msg, double GPSTime, double Latitude, double Longitude,
+inline bool NMEA0183SetRMC(tNMEA0183MsgBase &NMEA0183Msg, double GPSTime, double Latitude, double Longitude,
                       double TrueCOG, double SOG, unsigned long DaysSince1970, double Variation, const char *Src="GP") {
   return NMEA0183SetRMC(NMEA0183Msg,GPSTime,Latitude,Longitude,TrueCOG,SOG,DaysSince1970,Variation,0xff,0xff,Src);
 }
@@ -360,15 +380,17 @@ inline bool NMEA0183SetRMC(tNMEA0183Msg &NMEA0183Msg, double GPSTime, double Lat
 //*****************************************************************************
 // COG will be returned be in radians
 // SOG will be returned in m/s
-bool NMEA0183ParseVTG_nc(const tNMEA0183Msg &NMEA0183Msg, double &TrueCOG, double &MagneticCOG, double &SOG);
+bool NMEA0183ParseVTG_nc(const tNMEA0183MsgBase &NMEA0183Msg, double &TrueCOG, double &MagneticCOG, double &SOG);
+bool NMEA0183ParseVTG_nc(const tNMEA0183MsgView &NMEA0183Msg, double &TrueCOG, double &MagneticCOG, double &SOG);
 
-inline bool NMEA0183ParseVTG(const tNMEA0183Msg &NMEA0183Msg, double &TrueCOG, double &MagneticCOG, double &SOG) {
-  return (NMEA0183Msg.IsMessageCode("VTG")
+template<class tMsg>
+inline bool NMEA0183ParseVTG(const tMsg &NMEA0183Msg, double &TrueCOG, double &MagneticCOG, double &SOG) {
+  return (NMEA0183Msg.IsMessageCode(NMEA0183Code("VTG"))
             ?NMEA0183ParseVTG_nc(NMEA0183Msg,TrueCOG,MagneticCOG,SOG)
             :false);
 }
 
-bool NMEA0183SetVTG(tNMEA0183Msg &NMEA0183Msg, double TrueCOG, double MagneticCOG, double SOG, const char *Src="GP");
+bool NMEA0183SetVTG(tNMEA0183MsgBase &NMEA0183Msg, double TrueCOG, double MagneticCOG, double SOG, const char *Src="GP");
 
 // This is obsolet. Use NMEA0183SetVTG
 bool NMEA0183BuildVTG(char* msg, const char Src[], double TrueCOG, double MagneticCOG, double SOG);
@@ -376,136 +398,164 @@ bool NMEA0183BuildVTG(char* msg, const char Src[], double TrueCOG, double Magnet
 //*****************************************************************************
 // TrueHeading,MagneticHeading will be returned be in radians
 // SOW will be returned in m/s
-bool NMEA0183ParseVHW_nc(const tNMEA0183Msg &NMEA0183Msg, double &TrueHeading, double &MagneticHeading, double &SOW);
+bool NMEA0183ParseVHW_nc(const tNMEA0183MsgBase &NMEA0183Msg, double &TrueHeading, double &MagneticHeading, double &SOW);
+bool NMEA0183ParseVHW_nc(const tNMEA0183MsgView &NMEA0183Msg, double &TrueHeading, double &MagneticHeading, double &SOW);
 
-inline bool NMEA0183ParseVHW(const tNMEA0183Msg &NMEA0183Msg, double &TrueHeading, double &MagneticHeading, double &SOW) {
-  return (NMEA0183Msg.IsMessageCode("VHW")
+template<class tMsg>
+inline bool NMEA0183ParseVHW(const tMsg &NMEA0183Msg, double &TrueHeading, double &MagneticHeading, double &SOW) {
+  return (NMEA0183Msg.IsMessageCode(NMEA0183Code("VHW"))
             ?NMEA0183ParseVHW_nc(NMEA0183Msg,TrueHeading,MagneticHeading,SOW)
             :false);
 }
 
-bool NMEA0183SetVHW(tNMEA0183Msg &NMEA0183Msg, double TrueHeading, double MagneticHeading, double SOW, const char *Src="VW");
+bool NMEA0183SetVHW(tNMEA0183MsgBase &NMEA0183Msg, double TrueHeading, double MagneticHeading, double SOW, const char *Src="VW");
 
 //*****************************************************************************
 // Rate of turn will be returned be in radians
-bool NMEA0183ParseROT_nc(const tNMEA0183Msg &NMEA0183Msg,double &RateOfTurn);
+bool NMEA0183ParseROT_nc(const tNMEA0183MsgBase &NMEA0183Msg,double &RateOfTurn);
+bool NMEA0183ParseROT_nc(const tNMEA0183MsgView &NMEA0183Msg,double &RateOfTurn);
 
-inline bool NMEA0183ParseROT(const tNMEA0183Msg &NMEA0183Msg, double &RateOfTurn) {
-  return (NMEA0183Msg.IsMessageCode("ROT")
+template<class tMsg>
+inline bool NMEA0183ParseROT(const tMsg &NMEA0183Msg, double &RateOfTurn) {
+  return (NMEA0183Msg.IsMessageCode(NMEA0183Code("ROT"))
             ?NMEA0183ParseROT_nc(NMEA0183Msg,RateOfTurn)
             :false);
 }
 
-bool NMEA0183SetROT(tNMEA0183Msg &NMEA0183Msg, double RateOfTurn, const char *Src="GP");
+bool NMEA0183SetROT(tNMEA0183MsgBase &NMEA0183Msg, double RateOfTurn, const char *Src="GP");
 
 //*****************************************************************************
 // Heading will be returned be in radians
-bool NMEA0183ParseHDT_nc(const tNMEA0183Msg &NMEA0183Msg,double &TrueHeading);
+bool NMEA0183ParseHDT_nc(const tNMEA0183MsgBase &NMEA0183Msg,double &TrueHeading);
+bool NMEA0183ParseHDT_nc(const tNMEA0183MsgView &NMEA0183Msg,double &TrueHeading);
 
-inline bool NMEA0183ParseHDT(const tNMEA0183Msg &NMEA0183Msg, double &TrueHeading) {
-  return (NMEA0183Msg.IsMessageCode("HDT")
+template<class tMsg>
+inline bool NMEA0183ParseHDT(const tMsg &NMEA0183Msg, double &TrueHeading) {
+  return (NMEA0183Msg.IsMessageCode(NMEA0183Code("HDT"))
             ?NMEA0183ParseHDT_nc(NMEA0183Msg,TrueHeading)
             :false);
 }
 
-bool NMEA0183SetHDT(tNMEA0183Msg &NMEA0183Msg, double Heading, const char *Src="GP");
+bool NMEA0183SetHDT(tNMEA0183MsgBase &NMEA0183Msg, double Heading, const char *Src="GP");
 
 //*****************************************************************************
 // Heading will be returned be in radians
-bool NMEA0183ParseHDM_nc(const tNMEA0183Msg &NMEA0183Msg,double &MagneticHeading);
+bool NMEA0183ParseHDM_nc(const tNMEA0183MsgBase &NMEA0183Msg,double &MagneticHeading);
+bool NMEA0183ParseHDM_nc(const tNMEA0183MsgView &NMEA0183Msg,double &MagneticHeading);
 
-inline bool NMEA0183ParseHDM(const tNMEA0183Msg &NMEA0183Msg, double &MagneticHeading) {
-  return (NMEA0183Msg.IsMessageCode("HDM")
+template<class tMsg>
+inline bool NMEA0183ParseHDM(const tMsg &NMEA0183Msg, double &MagneticHeading) {
+  return (NMEA0183Msg.IsMessageCode(NMEA0183Code("HDM"))
             ?NMEA0183ParseHDT_nc(NMEA0183Msg,MagneticHeading)
             :false);
 }
 
-bool NMEA0183SetHDM(tNMEA0183Msg &NMEA0183Msg, double Heading, const char *Src="GP");
+bool NMEA0183SetHDM(tNMEA0183MsgBase &NMEA0183Msg, double Heading, const char *Src="GP");
 
 //*****************************************************************************
-bool NMEA0183SetHDG(tNMEA0183Msg &NMEA0183Msg, double Heading, double Deviation, double Variation, const char *Src="GP");
+bool NMEA0183SetHDG(tNMEA0183MsgBase &NMEA0183Msg, double Heading, double Deviation, double Variation, const char *Src="GP");
 
 //*****************************************************************************
 // VDM is basically a bitstream
-bool NMEA0183ParseVDM_nc(const tNMEA0183Msg &NMEA0183Msg,
+bool NMEA0183ParseVDM_nc(const tNMEA0183MsgBase &NMEA0183Msg,
+			uint8_t &pkgCnt, uint8_t &pkgNmb,
+			unsigned int &seqMessageId, char &channel,
+			unsigned int &length, char *bitstream,
+			unsigned int &fillBits);
+bool NMEA0183ParseVDM_nc(const tNMEA0183MsgView &NMEA0183Msg,
 			uint8_t &pkgCnt, uint8_t &pkgNmb,
 			unsigned int &seqMessageId, char &channel,
 			unsigned int &length, char *bitstream,
 			unsigned int &fillBits);
 
 
-inline bool NMEA0183ParseVDM(const tNMEA0183Msg &NMEA0183Msg, uint8_t &pkgCnt, uint8_t &pkgNmb,
+template<class tMsg>
+inline bool NMEA0183ParseVDM(const tMsg &NMEA0183Msg, uint8_t &pkgCnt, uint8_t &pkgNmb,
 						unsigned int &seqMessageId, char &channel,
 						unsigned int &length, char* bitstream, unsigned int &fillBits) {
-  return (NMEA0183Msg.IsMessageCode("VDM") ?
+  return (NMEA0183Msg.IsMessageCode(NMEA0183Code("VDM")) ?
 		NMEA0183ParseVDM_nc(NMEA0183Msg, pkgCnt, pkgNmb, seqMessageId, channel, length, bitstream, fillBits) : false);
 }
-bool NMEA0183SetVDM(tNMEA0183Msg &NMEA0183Msg, char *channel, char *bitstream, const char *Src="AI");
-bool NMEA0183SetVDM(tNMEA0183Msg &NMEA0183Msg, char *channel, char *bitstream,  uint32_t count, uint32_t number, uint32_t id, uint32_t fillbits, const char *Src="AI");
-bool NMEA0183SetVDO(tNMEA0183Msg &NMEA0183Msg, char *channel, char *bitstream, const char *Src="AI");
-bool NMEA0183SetVDO(tNMEA0183Msg &NMEA0183Msg, char *channel, char *bitstream,  uint32_t count, uint32_t number, uint32_t id, uint32_t fillbits, const char *Src="AI");
+bool NMEA0183SetVDM(tNMEA0183MsgBase &NMEA0183Msg, char *channel, char *bitstream, const char *Src="AI");
+bool NMEA0183SetVDM(tNMEA0183MsgBase &NMEA0183Msg, char *channel, char *bitstream,  uint32_t count, uint32_t number, uint32_t id, uint32_t fillbits, const char *Src="AI");
+bool NMEA0183SetVDO(tNMEA0183MsgBase &NMEA0183Msg, char *channel, char *bitstream, const char *Src="AI");
+bool NMEA0183SetVDO(tNMEA0183MsgBase &NMEA0183Msg, char *channel, char *bitstream,  uint32_t count, uint32_t number, uint32_t id, uint32_t fillbits, const char *Src="AI");
 //*****************************************************************************
 //Parse a single NMEA0183 RTE message into a tRTE struct.
 //Depending on the size of the route a GPS will send a single RTE message or send multiple RTE messages via NMEA0183.
 //This method only handles a single RTE message. Handling a sequence of RTE messages is outside of the scope of this lib.
 //This should be handled in the calling lib. An example lib which handles a sequence of RTE messages can be found here: https://github.com/tonswieb/NMEAGateway
 //$GPRTE,2,1,c,0,W3IWI,DRIVWY,32CEDR,32-29,32BKLD,32-I95,32-US1,BW-32,BW-198*69
-bool NMEA0183ParseRTE_nc(const tNMEA0183Msg &NMEA0183Msg, tRTE &rte);
+bool NMEA0183ParseRTE_nc(const tNMEA0183MsgBase &NMEA0183Msg, tRTE &rte);
+bool NMEA0183ParseRTE_nc(const tNMEA0183MsgView &NMEA0183Msg, tRTE &rte);
 
-inline bool NMEA0183ParseRTE(const tNMEA0183Msg &NMEA0183Msg, tRTE &rte) {
-	return (NMEA0183Msg.IsMessageCode("RTE") ?
+template<class tMsg>
+inline bool NMEA0183ParseRTE(const tMsg &NMEA0183Msg, tRTE &rte) {
+	return (NMEA0183Msg.IsMessageCode(NMEA0183Code("RTE")) ?
 					NMEA0183ParseRTE_nc(NMEA0183Msg,rte) : false);
 }
 
 //*****************************************************************************
 //$GPWPL,5208.700,N,00438.600,E,MOLENB*4D
-bool NMEA0183ParseWPL_nc(const tNMEA0183Msg &NMEA0183Msg, tWPL &wpl);
+bool NMEA0183ParseWPL_nc(const tNMEA0183MsgBase &NMEA0183Msg, tWPL &wpl);
+bool NMEA0183ParseWPL_nc(const tNMEA0183MsgView &NMEA0183Msg, tWPL &wpl);
 
-inline bool NMEA0183ParseWPL(const tNMEA0183Msg &NMEA0183Msg, tWPL &wpl) {
-	return (NMEA0183Msg.IsMessageCode("WPL") ?
+template<class tMsg>
+inline bool NMEA0183ParseWPL(const tMsg &NMEA0183Msg, tWPL &wpl) {
+	return (NMEA0183Msg.IsMessageCode(NMEA0183Code("WPL")) ?
 					NMEA0183ParseWPL_nc(NMEA0183Msg,wpl) : false);
 }
 
 //*****************************************************************************
-bool NMEA0183ParseBOD_nc(const tNMEA0183Msg &NMEA0183Msg, tBOD &bod);
+bool NMEA0183ParseBOD_nc(const tNMEA0183MsgBase &NMEA0183Msg, tBOD &bod);
+bool NMEA0183ParseBOD_nc(const tNMEA0183MsgView &NMEA0183Msg, tBOD &bod);
 
-inline bool NMEA0183ParseBOD(const tNMEA0183Msg &NMEA0183Msg, tBOD &bod) {
-	return (NMEA0183Msg.IsMessageCode("BOD") ?
+template<class tMsg>
+inline bool NMEA0183ParseBOD(const tMsg &NMEA0183Msg, tBOD &bod) {
+	return (NMEA0183Msg.IsMessageCode(NMEA0183Code("BOD")) ?
 					NMEA0183ParseBOD_nc(NMEA0183Msg,bod) : false);
 }
 
 //*****************************************************************************
 // MWV - Wind Speed and Angle
-bool NMEA0183ParseMWV_nc(const tNMEA0183Msg &NMEA0183Msg,double &WindAngle, tNMEA0183WindReference &Reference, double &WindSpeed);
+bool NMEA0183ParseMWV_nc(const tNMEA0183MsgBase &NMEA0183Msg,double &WindAngle, tNMEA0183WindReference &Reference, double &WindSpeed);
+bool NMEA0183ParseMWV_nc(const tNMEA0183MsgView &NMEA0183Msg,double &WindAngle, tNMEA0183WindReference &Reference, double &WindSpeed);
 
-inline bool NMEA0183ParseMWV(const tNMEA0183Msg &NMEA0183Msg,double &WindAngle, tNMEA0183WindReference &Reference, double &WindSpeed) {
-  return (NMEA0183Msg.IsMessageCode("MWV")
+template<class tMsg>
+inline bool NMEA0183ParseMWV(const tMsg &NMEA0183Msg,double &WindAngle, tNMEA0183WindReference &Reference, double &WindSpeed) {
+  return (NMEA0183Msg.IsMessageCode(NMEA0183Code("MWV"))
             ?NMEA0183ParseMWV_nc(NMEA0183Msg,WindAngle,Reference,WindSpeed)
             :false);
 }
 
-bool NMEA0183SetMWV(tNMEA0183Msg &NMEA0183Msg, double WindAngle, tNMEA0183WindReference Reference, double WindSpeed, const char *Src="II");
+bool NMEA0183SetMWV(tNMEA0183MsgBase &NMEA0183Msg, double WindAngle, tNMEA0183WindReference Reference, double WindSpeed, const char *Src="II");
 //*****************************************************************************
 // GSV - GPS Satellites in view
-bool NMEA0183SetGSV(tNMEA0183Msg &NMEA0183Msg, uint32_t totalMSG, uint32_t thisMSG, uint32_t SatelliteCount, 
+bool NMEA0183SetGSV(tNMEA0183MsgBase &NMEA0183Msg, uint32_t totalMSG, uint32_t thisMSG, uint32_t SatelliteCount, 
 					uint32_t PRN1, uint32_t Elevation1, uint32_t Azimuth1, uint32_t SNR1,
 					uint32_t PRN2, uint32_t Elevation2, uint32_t Azimuth2, uint32_t SNR2,
 					uint32_t PRN3, uint32_t Elevation3, uint32_t Azimuth3, uint32_t SNR3,
 					uint32_t PRN4, uint32_t Elevation4, uint32_t Azimuth4, uint32_t SNR4,
 					const char *Src="GP");
 
-bool NMEA0183ParseGSV_nc(const tNMEA0183Msg &NMEA0183Msg, int &totalMSG, int &thisMSG, int &SatelliteCount,
+bool NMEA0183ParseGSV_nc(const tNMEA0183MsgBase &NMEA0183Msg, int &totalMSG, int &thisMSG, int &SatelliteCount,
+                        struct tGSV &Msg1,
+                        struct tGSV &Msg2,
+                        struct tGSV &Msg3,
+                        struct tGSV &Msg4);
+bool NMEA0183ParseGSV_nc(const tNMEA0183MsgView &NMEA0183Msg, int &totalMSG, int &thisMSG, int &SatelliteCount,
                         struct tGSV &Msg1,
                         struct tGSV &Msg2,
                         struct tGSV &Msg3,
                         struct tGSV &Msg4);
                         
-inline bool NMEA0183ParseGSV(const tNMEA0183Msg &NMEA0183Msg, int &totalMSG, int &thisMSG, int &SatelliteCount,
+template<class tMsg>
+inline bool NMEA0183ParseGSV(const tMsg &NMEA0183Msg, int &totalMSG, int &thisMSG, int &SatelliteCount,
                         struct tGSV &Msg1,
                         struct tGSV &Msg2,
                         struct tGSV &Msg3,
                         struct tGSV &Msg4) {
-  return (NMEA0183Msg.IsMessageCode("GSV")
+  return (NMEA0183Msg.IsMessageCode(NMEA0183Code("GSV"))
             ?NMEA0183ParseGSV_nc(NMEA0183Msg,totalMSG,thisMSG,SatelliteCount,
                                  Msg1,Msg2,Msg3,Msg4)
             :false);
@@ -513,23 +563,29 @@ inline bool NMEA0183ParseGSV(const tNMEA0183Msg &NMEA0183Msg, int &totalMSG, int
 
 //*****************************************************************************
 // ZDA - Time & Date
-bool NMEA0183ParseZDA(const tNMEA0183Msg &NMEA0183Msg, double &GPSTime, int &GPSDay,
+bool NMEA0183ParseZDA(const tNMEA0183MsgBase &NMEA0183Msg, double &GPSTime, int &GPSDay,
+					int &GPSMonth, int &GPSYear, int &LZD, int &LZMD);
+bool NMEA0183ParseZDA(const tNMEA0183MsgView &NMEA0183Msg, double &GPSTime, int &GPSDay,
 					int &GPSMonth, int &GPSYear, int &LZD, int &LZMD);
 
-bool NMEA0183ParseZDA(const tNMEA0183Msg &NMEA0183Msg, time_t &DateTime, long &Timezone);
+bool NMEA0183ParseZDA(const tNMEA0183MsgBase &NMEA0183Msg, time_t &DateTime, long &Timezone);
+bool NMEA0183ParseZDA(const tNMEA0183MsgView &NMEA0183Msg, time_t &DateTime, long &Timezone);
 
-inline bool NMEA0183ParseZDA(const tNMEA0183Msg &NMEA0183Msg, tZDA &zda) {
+template<class tMsg>
+inline bool NMEA0183ParseZDA(const tMsg &NMEA0183Msg, tZDA &zda) {
 
 	return NMEA0183ParseZDA(NMEA0183Msg, zda.GPSTime, zda.GPSDay, zda.GPSMonth, zda.GPSYear, zda.LZD, zda.LZMD);
 }
 
-bool NMEA0183SetZDA(tNMEA0183Msg& NMEA0183Msg, double GPSTime, int GPSDay, int GPSMonth, int GPSYear, int LZD, int LZMD, const char* Src ="GP");
+bool NMEA0183SetZDA(tNMEA0183MsgBase& NMEA0183Msg, double GPSTime, int GPSDay, int GPSMonth, int GPSYear, int LZD, int LZMD, const char* Src ="GP");
 //*****************************************************************************
 //$GPAPB,A,A,0.10,R,N,V,V,011,M,DEST,011,M,011,M*82
-bool NMEA0183ParseAPB_nc(const tNMEA0183Msg &NMEA0183Msg, tAPB &apb);
+bool NMEA0183ParseAPB_nc(const tNMEA0183MsgBase &NMEA0183Msg, tAPB &apb);
+bool NMEA0183ParseAPB_nc(const tNMEA0183MsgView &NMEA0183Msg, tAPB &apb);
 
-inline bool NMEA0183ParseAPB(const tNMEA0183Msg &NMEA0183Msg, tAPB &apb) {
-    return (NMEA0183Msg.IsMessageCode("APB") ?
+template<class tMsg>
+inline bool NMEA0183ParseAPB(const tMsg &NMEA0183Msg, tAPB &apb) {
+    return (NMEA0183Msg.IsMessageCode(NMEA0183Code("APB")) ?
         NMEA0183ParseAPB_nc(NMEA0183Msg, apb) : false);
 }
 
@@ -537,16 +593,18 @@ inline bool NMEA0183ParseAPB(const tNMEA0183Msg &NMEA0183Msg, tAPB &apb) {
 // RT300 proprietary roll and pitch sentence
 //        UTC        Hdg    T Roll  Pitch Heave R.Acc P.Acc H.Acc Q S
 // $PASHR,163029.000,158.09,T,-0.30,+0.31,+0.01,0.029,0.029,0.059,1,1*3B
-bool NMEA0183SetSHR(tNMEA0183Msg& NMEA0183Msg, double GPSTime, const double HeadingRad, const double RollRad, const double PitchRad, double HeaveM, double RollAccuracyRad, double PitchAccuracyRad, double HeadingAccuracyRad, int GPSQualityIndicator, int INSStatusFlag, const char* Source);
+bool NMEA0183SetSHR(tNMEA0183MsgBase& NMEA0183Msg, double GPSTime, const double HeadingRad, const double RollRad, const double PitchRad, double HeaveM, double RollAccuracyRad, double PitchAccuracyRad, double HeadingAccuracyRad, int GPSQualityIndicator, int INSStatusFlag, const char* Source);
 
 //*****************************************************************************
 // MTW
-bool NMEA0183ParseMTW_nc(const tNMEA0183Msg &NMEA0183Msg, double &Watertemp);
+bool NMEA0183ParseMTW_nc(const tNMEA0183MsgBase &NMEA0183Msg, double &Watertemp);
+bool NMEA0183ParseMTW_nc(const tNMEA0183MsgView &NMEA0183Msg, double &Watertemp);
 
-inline bool NMEA0183ParseMTW(const tNMEA0183Msg &NMEA0183Msg, double &Watertemp) {
+template<class tMsg>
+inline bool NMEA0183ParseMTW(const tMsg &NMEA0183Msg, double &Watertemp) {
   return NMEA0183ParseMTW_nc(NMEA0183Msg, Watertemp);
 }
 
-bool NMEA0183SetMTW(tNMEA0183Msg &NMEA0183Msg, double WaterTemp, const char *Src="VW");
+bool NMEA0183SetMTW(tNMEA0183MsgBase &NMEA0183Msg, double WaterTemp, const char *Src="VW");
 
 #endif
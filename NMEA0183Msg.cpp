@@ -53,78 +53,162 @@ extern uint32_t millis();
 }
 #endif
 
-const char *const tNMEA0183Msg::EmptyField="";
-const char *const tNMEA0183Msg::DefDoubleFormat="%.1f";
+const char *const tNMEA0183MsgBase::EmptyField="";
+const char *const tNMEA0183MsgBase::DefDoubleFormat="%.1f";
 
 //*****************************************************************************
-tNMEA0183Msg::tNMEA0183Msg() {
-  Clear();
+tNMEA0183MsgBase::tNMEA0183MsgBase(char *_Data, uint8_t _MaxLen, uint8_t *_Fields, uint8_t *_FieldLens, uint8_t _MaxFields)
+: Data(_Data), MaxLen(_MaxLen), Fields(_Fields), FieldLens(_FieldLens), MaxFields(_MaxFields) {
 }
 
 //*****************************************************************************
-bool tNMEA0183Msg::SetMessage(const char *buf) {
-  unsigned char csMsg;
-  int i=0;
-  uint8_t iData=0;
-  bool result=false;
+bool tNMEA0183MsgBase::CopyFrom(const tNMEA0183MsgBase &Msg) {
+  if ( &Msg==this ) return true;
+
+  if ( Msg.iAddData>MaxLen || Msg._FieldCount>MaxFields ) { // Does not fit
+    Clear();
+    return false;
+  }
+
+  memcpy(Data,Msg.Data,( Msg.iAddData>4?Msg.iAddData:4 ));
+  memcpy(Fields,Msg.Fields,Msg._FieldCount*sizeof(Fields[0]));
+  memcpy(FieldLens,Msg.FieldLens,Msg._FieldCount*sizeof(FieldLens[0]));
+  _MessageTime=Msg._MessageTime;
+  _RxTime=Msg._RxTime;
+  iAddData=Msg.iAddData;
+  Prefix=Msg.Prefix;
+  _FieldCount=Msg._FieldCount;
+  CheckSum=Msg.CheckSum;
+  _MessageCodeKey=Msg._MessageCodeKey;
+  _SenderKey=Msg._SenderKey;
+  _TagBlock=Msg._TagBlock;
+  SourceID=Msg.SourceID;
 
+  return true;
+}
+
+//*****************************************************************************
+bool tNMEA0183MsgBase::SetMessage(const char *buf) {
   Clear();
-  _MessageTime=millis();
 
-  if ( buf[i]!='$' &&  buf[i]!='!' ) return result; // Invalid message
-  Prefix=buf[i];
-  i++; // Pass start prefix
+  if ( buf==0 ) return false;
+
+  if ( buf[0]=='\\' ) return SetMessage(buf,strlen(buf));
 
-//  Serial.println(buf);
-  // Set sender
-  for (; iData<2 && buf[i]!=0; i++, iData++) {
-    CheckSum^=buf[i];
-    Data[iData]=buf[i];
+  const char *DataEnd=buf;
+  for (; *DataEnd!='*' && *DataEnd!=0; DataEnd++);
+
+  if ( DataEnd[0]!='*' || DataEnd[1]==0 || DataEnd[2]==0 ) return false; // No checksum -> invalid message
+
+  return SetReceived(buf,DataEnd);
+}
+
+//*****************************************************************************
+bool tNMEA0183MsgBase::SetMessage(const char *buf, size_t len) {
+  Clear();
+
+  if ( buf==0 || len==0 ) return false;
+
+  tNMEA0183TagBlock Tag;
+
+  if ( buf[0]=='\\' ) { // TAG block
+    const char *TagEnd=(const char *)memchr(buf+1,'\\',len-1);
+    if ( TagEnd==0 || !Tag.SetTagBlock(buf+1,TagEnd-buf-1) ) return false;
+    len-=TagEnd+1-buf;
+    buf=TagEnd+1;
+    if ( len==0 ) return false;
   }
 
-  if (buf[i]==0) { Clear(); return result; } // Invalid message
+  const char *DataEnd=(const char *)memchr(buf,'*',len);
+
+  if ( DataEnd==0 || DataEnd+2>=buf+len ) return false; // No checksum -> invalid message
 
-  Data[iData]=0; iData++; // null termination for sender
-  // Set message code. Read until next comma
-  for (; buf[i]!=',' && buf[i]!=0 && iData<MAX_NMEA0183_MSG_LEN; i++, iData++) {
-    CheckSum^=buf[i];
-    Data[iData]=buf[i];
+  if ( !SetReceived(buf,DataEnd) ) return false;
+
+  _TagBlock=Tag;
+  return true;
+}
+
+//*****************************************************************************
+bool tNMEA0183MsgBase::SetReceived(const char *buf, const char *DataEnd) {
+  if ( buf[0]!='$' &&  buf[0]!='!' ) return false; // Invalid message
+
+  StartReceive(buf[0]);
+  if ( !AddReceived(buf+1,DataEnd-buf-1) ||
+       !EndReceiveData() ||
+       !EndReceive((HexToNibble(DataEnd[1])<<4) | HexToNibble(DataEnd[2])) ) {
+    Clear();
+    return false;
   }
-  if (buf[i]!=',') { Clear(); return result; } // No separation after message code -> invalid message
-
-  // Set the data and calculate checksum. Read until '*'
-  for (; buf[i]!='*' && buf[i]!=0 && iData<MAX_NMEA0183_MSG_LEN; i++, iData++) {
-    CheckSum^=buf[i];
-    Data[iData]=buf[i];
-    if (buf[i]==',') { // New field
-      Data[iData]=0; // null termination for previous field
-      if (_FieldCount >= MAX_NMEA0183_MSG_FIELDS ) {
-        Clear();
-        return false;
+
+  return true;
+}
+
+//*****************************************************************************
+void tNMEA0183MsgBase::StartReceive(char _Prefix) {
+  Clear();
+  Prefix=_Prefix;
+}
+
+//*****************************************************************************
+// Sender is two first characters. Message code continues until first comma, which
+// also starts first field. After that each comma starts new field.
+bool tNMEA0183MsgBase::AddReceived(const char *buf, size_t len) {
+  uint8_t cs=CheckSum;
+
+  for (; len>0; buf++, len--) {
+    char c=*buf;
+    cs^=c;
+    if ( iAddData<2 ) { // Sender
+      Data[iAddData]=c;
+      iAddData++;
+      if ( iAddData==2 ) { Data[2]=0; iAddData=3; } // null termination for sender
+      continue;
+    }
+    if ( iAddData>=MaxLen-1 ) return false; // Keep room for null termination
+    if ( c==',' ) { // New field
+      if ( _FieldCount>=MaxFields ) return false;
+      if ( _FieldCount>0 ) {
+        FieldLens[_FieldCount-1]=iAddData-Fields[_FieldCount-1];
+        Data[iAddData]=0; // null termination for previous field
+      } else { // Header ready
+        Data[iAddData]=0; // null termination for message code
+        _MessageCodeKey=NMEA0183Code(Data+3);
+        _SenderKey=NMEA0183Sender(Data);
       }
-      Fields[_FieldCount]=iData+1;   // Set start of field
+      iAddData++;
+      Fields[_FieldCount]=iAddData;   // Set start of field
       _FieldCount++;
+    } else {
+      Data[iAddData]=c;
+      iAddData++;
     }
   }
 
-  if (buf[i]!='*') { Clear(); return false; } // No checksum -> invalid message
-  Data[iData]=0; // null termination for previous field
-  i++; // Pass '*';
-  // Added test to allow lower case chcksum.
-  csMsg=(buf[i]<=57?buf[i]-48:(buf[i]<=70?buf[i]-55:buf[i]-87))<<4; i++;
-  csMsg|=(buf[i]<=57?buf[i]-48:(buf[i]<=70?buf[i]-55:buf[i]-87));
+  CheckSum=cs;
+  return true;
+}
+
+//*****************************************************************************
+bool tNMEA0183MsgBase::EndReceiveData() {
+  if ( _FieldCount==0 ) return false; // No separation after message code -> invalid message
 
-  if (csMsg==CheckSum) {
-    result=true;
-  } else {
-    Clear();
-  }
+  FieldLens[_FieldCount-1]=iAddData-Fields[_FieldCount-1];
+  Data[iAddData]=0; // null termination for last field
+  iAddData++;
+  return true;
+}
 
-  return result;
+//*****************************************************************************
+bool tNMEA0183MsgBase::EndReceive(uint8_t RxCheckSum) {
+  if ( RxCheckSum!=CheckSum ) return false;
+
+  _MessageTime=millis();
+  return true;
 }
 
 //*****************************************************************************
-bool tNMEA0183Msg::AddToBuf(const char *data, char * &buf, size_t &BufSize) const {
+bool tNMEA0183MsgBase::AddToBuf(const char *data, char * &buf, size_t &BufSize) const {
   size_t len=strlen(data);
 
   if ( len+1>BufSize ) return false;
@@ -136,7 +220,7 @@ bool tNMEA0183Msg::AddToBuf(const char *data, char * &buf, size_t &BufSize) cons
 }
 
 //*****************************************************************************
-bool tNMEA0183Msg::GetMessage(char *MsgData, size_t BufSize) const {
+bool tNMEA0183MsgBase::GetMessage(char *MsgData, size_t BufSize) const {
   if ( MsgData==0 || BufSize<14 ) return false;
 
   MsgData[0]=GetPrefix();
@@ -155,7 +239,7 @@ bool tNMEA0183Msg::GetMessage(char *MsgData, size_t BufSize) const {
 }
 
 //*****************************************************************************
-bool tNMEA0183Msg::Init(const char *_MessageCode, const char *_Sender, char _Prefix) {
+bool tNMEA0183MsgBase::Init(const char *_MessageCode, const char *_Sender, char _Prefix) {
   Clear();
   size_t nSender=2;
   size_t nMessageCode=0;
@@ -176,18 +260,21 @@ bool tNMEA0183Msg::Init(const char *_MessageCode, const char *_Sender, char _Pre
   iAddData=3+nMessageCode+1;
 
   for ( int i=3; Data[i]!=0; i++ ) CheckSum^=Data[i];
+  _MessageCodeKey=NMEA0183Code(MessageCode());
+  _SenderKey=NMEA0183Sender(Sender());
 
   return true;
 }
 
 //*****************************************************************************
-bool tNMEA0183Msg::AddEmptyField() {
-  if ( iAddData>=MAX_NMEA0183_MSG_LEN ||
-       _FieldCount>=MAX_NMEA0183_MSG_FIELDS ) return false; // Is there room for any data
+bool tNMEA0183MsgBase::AddEmptyField() {
+  if ( iAddData>=MaxLen ||
+       _FieldCount>=MaxFields ) return false; // Is there room for any data
 
   Data[iAddData]=0;
   CheckSum^=',';
   Fields[_FieldCount]=iAddData;   // Set start of field
+  FieldLens[_FieldCount]=0;
   iAddData++;
   _FieldCount++;
 
@@ -195,9 +282,9 @@ bool tNMEA0183Msg::AddEmptyField() {
 }
 
 //*****************************************************************************
-bool tNMEA0183Msg::AddStrField(const char *FieldData) {
-  if ( iAddData>=MAX_NMEA0183_MSG_LEN ||
-       _FieldCount>=MAX_NMEA0183_MSG_FIELDS ) return false; // Is there room for any data
+bool tNMEA0183MsgBase::AddStrField(const char *FieldData) {
+  if ( iAddData>=MaxLen ||
+       _FieldCount>=MaxFields ) return false; // Is there room for any data
 
   int i=0;
   uint8_t cs=CheckSum;
@@ -207,7 +294,7 @@ bool tNMEA0183Msg::AddStrField(const char *FieldData) {
   cs^=',';
   Fields[_FieldCount]=iAdd;   // Set start of field
   if ( FieldData!=0 ) {
-    for (;iAdd<MAX_NMEA0183_MSG_LEN-1 && FieldData[i]!=0; i++,iAdd++) {
+    for (;iAdd<MaxLen-1 && FieldData[i]!=0; i++,iAdd++) {
       Data[iAdd]=FieldData[i];
       cs^=FieldData[i];
     }
@@ -215,6 +302,7 @@ bool tNMEA0183Msg::AddStrField(const char *FieldData) {
   Data[iAdd]=0;
   if ( FieldData!=0 && FieldData[i]!=0 ) return false; // Return false, if FieldData does not fit.
 
+  FieldLens[_FieldCount]=i;
   iAddData=iAdd+1;
   _FieldCount++;
   CheckSum=cs;
@@ -222,7 +310,7 @@ bool tNMEA0183Msg::AddStrField(const char *FieldData) {
 }
 
 //*****************************************************************************
-bool tNMEA0183Msg::AddStrField(char FieldData) {
+bool tNMEA0183MsgBase::AddStrField(char FieldData) {
   char Str[2];
   Str[0]=FieldData;
   Str[1]=0;
@@ -230,23 +318,24 @@ bool tNMEA0183Msg::AddStrField(char FieldData) {
 }
 
 //*****************************************************************************
-bool tNMEA0183Msg::AddUInt32Field(uint32_t val) {
+bool tNMEA0183MsgBase::AddUInt32Field(uint32_t val) {
   if ( val==NMEA0183UInt32NA ) return AddEmptyField();
 
-  if ( iAddData>=MAX_NMEA0183_MSG_LEN ||
-       _FieldCount>=MAX_NMEA0183_MSG_FIELDS ) return false; // Is there room for any data
+  if ( iAddData>=MaxLen ||
+       _FieldCount>=MaxFields ) return false; // Is there room for any data
 
   int needSize;
   uint8_t cs=CheckSum;
 
   cs^=',';
   Fields[_FieldCount]=iAddData;   // Set start of field
-  needSize=snprintf((Data+iAddData),MAX_NMEA0183_MSG_LEN-iAddData,"%lu",(unsigned long)val);
+  needSize=snprintf((Data+iAddData),MaxLen-iAddData,"%lu",(unsigned long)val);
   ForceNullTermination();
 
-  if ( needSize>MAX_NMEA0183_MSG_LEN-1-iAddData ) return false;
+  if ( needSize>MaxLen-1-iAddData ) return false;
 
   for ( int i=iAddData; Data[i]!=0; i++ ) cs^=Data[i];
+  FieldLens[_FieldCount]=needSize;
   iAddData+=needSize+1;
 
   _FieldCount++;
@@ -255,15 +344,15 @@ bool tNMEA0183Msg::AddUInt32Field(uint32_t val) {
 }
 
 //*****************************************************************************
-bool tNMEA0183Msg::AddDoubleField(double val, double multiplier, const char *Format, const char *Unit) {
+bool tNMEA0183MsgBase::AddDoubleField(double val, double multiplier, const char *Format, const char *Unit) {
   if ( NMEA0183IsNA(val) ) {
     bool ret=AddEmptyField();
     if ( Unit!=0 ) ret=AddStrField(Unit);
     return ret;
   }
 
-  if ( iAddData>=MAX_NMEA0183_MSG_LEN ||
-       _FieldCount>=MAX_NMEA0183_MSG_FIELDS ) return false; // Is there room for any data
+  if ( iAddData>=MaxLen ||
+       _FieldCount>=MaxFields ) return false; // Is there room for any data
 
   int needSize;
   uint8_t cs=CheckSum;
@@ -271,7 +360,7 @@ bool tNMEA0183Msg::AddDoubleField(double val, double multiplier, const char *For
   cs^=',';
   Fields[_FieldCount]=iAddData;   // Set start of field
   #ifndef NO_PRINTF_DOUBLE_SUPPORT
-  needSize=snprintf((Data+iAddData),MAX_NMEA0183_MSG_LEN-iAddData,Format,val*multiplier);
+  needSize=snprintf((Data+iAddData),MaxLen-iAddData,Format,val*multiplier);
   ForceNullTermination();
   #else
   char StrVal[20];
@@ -293,15 +382,16 @@ bool tNMEA0183Msg::AddDoubleField(double val, double multiplier, const char *For
   // Convert to string.
   dtostrf(val*multiplier, width, precision, StrVal);
   needSize=strlen(StrVal);
-  if ( needSize<MAX_NMEA0183_MSG_LEN-iAddData ) {
+  if ( needSize<MaxLen-iAddData ) {
     if ( Padding ) for ( char *s=StrVal; *s==' '; *s='0', s++);
     strcpy((Data+iAddData),StrVal);
   }
   #endif
 
-  if ( needSize>MAX_NMEA0183_MSG_LEN-1-iAddData ) return false;
+  if ( needSize>MaxLen-1-iAddData ) return false;
 
   for ( int i=iAddData; Data[i]!=0; i++ ) cs^=Data[i];
+  FieldLens[_FieldCount]=needSize;
   iAddData+=needSize+1;
 
   _FieldCount++;
@@ -313,23 +403,23 @@ bool tNMEA0183Msg::AddDoubleField(double val, double multiplier, const char *For
 }
 
 //*****************************************************************************
-bool tNMEA0183Msg::AddTimeField(double GPSTime, const char *Format) {
+bool tNMEA0183MsgBase::AddTimeField(double GPSTime, const char *Format) {
   return AddDoubleField(GPSTimeToNMEA0183Time(GPSTime),1,Format);
 }
 
 //*****************************************************************************
-bool tNMEA0183Msg::AddDaysField(unsigned long DaysSince1970) {
+bool tNMEA0183MsgBase::AddDaysField(unsigned long DaysSince1970) {
   if ( DaysSince1970==NMEA0183UInt32NA  ) return AddEmptyField();
 
   return AddDoubleField(DaysToNMEA0183Date(DaysSince1970),1,"%06.0f");
 }
 
 //*****************************************************************************
-bool tNMEA0183Msg::AddLatitudeField(double Latitude, const char *Format) {
+bool tNMEA0183MsgBase::AddLatitudeField(double Latitude, const char *Format) {
   if ( Latitude==NMEA0183DoubleNA ) return AddEmptyField() & AddEmptyField();
 
-  if ( iAddData>=MAX_NMEA0183_MSG_LEN-8 ||
-       _FieldCount>=MAX_NMEA0183_MSG_FIELDS-1 ) return false; // Is there room for any data
+  if ( iAddData>=MaxLen-8 ||
+       _FieldCount>=MaxFields-1 ) return false; // Is there room for any data
 
   if ( ! AddDoubleField(DoubleToddmm((Latitude>=0?Latitude:-Latitude)),1,Format) ) return false; // abs generated -0.00 for 0.00??
 
@@ -339,11 +429,11 @@ bool tNMEA0183Msg::AddLatitudeField(double Latitude, const char *Format) {
 }
 
 //*****************************************************************************
-bool tNMEA0183Msg::AddLongitudeField(double Longitude, const char *Format) {
+bool tNMEA0183MsgBase::AddLongitudeField(double Longitude, const char *Format) {
   if ( Longitude==NMEA0183DoubleNA ) return AddEmptyField() & AddEmptyField();
 
-  if ( iAddData>=MAX_NMEA0183_MSG_LEN-8 ||
-       _FieldCount>=MAX_NMEA0183_MSG_FIELDS-1 ) return false; // Is there room for any data
+  if ( iAddData>=MaxLen-8 ||
+       _FieldCount>=MaxFields-1 ) return false; // Is there room for any data
 
   if ( ! AddDoubleField(DoubleToddmm((Longitude>=0?Longitude:-Longitude)),1,Format) ) return false; // abs generated -0.00 for 0.00??
 
@@ -354,24 +444,29 @@ bool tNMEA0183Msg::AddLongitudeField(double Longitude, const char *Format) {
 
 
 //*****************************************************************************
-void tNMEA0183Msg::Clear() {
+void tNMEA0183MsgBase::Clear() {
   SourceID=0;
   Data[0]=0;  // Sender is empty
-  Data[2]=0;  // Message code is empty
+  Data[2]=0;  // Sender null termination
+  Data[3]=0;  // Message code is empty
+  _MessageCodeKey=0;
+  _SenderKey=0;
+  _TagBlock.Clear();
   iAddData=0;
   _FieldCount=0;
   Fields[0]=0;
   _MessageTime=0;
+  _RxTime=0;
   CheckSum=0;
   Prefix=' ';
 }
 
 //*****************************************************************************
-//void tNMEA0183Msg::PrintFields(Stream &port) const {
+//void tNMEA0183MsgBase::PrintFields(Stream &port) const {
 //}
 
 //*****************************************************************************
-void tNMEA0183Msg::Send(tNMEA0183Stream &port) const {
+void tNMEA0183MsgBase::Send(tNMEA0183Stream &port) const {
   if (FieldCount()==0) return;
   port.print(Prefix);
   port.print(Sender());
@@ -388,7 +483,7 @@ void tNMEA0183Msg::Send(tNMEA0183Stream &port) const {
 }
 
 //*****************************************************************************
-const char *tNMEA0183Msg::Field(uint8_t index) const {
+const char *tNMEA0183MsgBase::Field(uint8_t index) const {
   if (index<FieldCount()) {
     return Data+Fields[index];
   } else {
@@ -397,16 +492,16 @@ const char *tNMEA0183Msg::Field(uint8_t index) const {
 }
 
 //*****************************************************************************
-unsigned int tNMEA0183Msg::FieldLen(uint8_t index) const {
+unsigned int tNMEA0183MsgBase::FieldLen(uint8_t index) const {
   if (index<FieldCount()) {
-    return strlen(Data+Fields[index]);
+    return FieldLens[index];
   } else {
     return 0;
   }
 }
 
 //*****************************************************************************
-double tNMEA0183Msg::GPSTimeToNMEA0183Time(double GPSTime) {
+double tNMEA0183MsgBase::GPSTimeToNMEA0183Time(double GPSTime) {
   if ( GPSTime==NMEA0183DoubleNA ) return GPSTime;
 
   double intpart;
@@ -423,7 +518,7 @@ double tNMEA0183Msg::GPSTimeToNMEA0183Time(double GPSTime) {
 }
 
 //*****************************************************************************
-double tNMEA0183Msg::DoubleToddmm(double val) {
+double tNMEA0183MsgBase::DoubleToddmm(double val) {
   if ( val!=NMEA0183DoubleNA  ) {
     double intpart;
     val=modf(val,&intpart);
@@ -433,10 +528,10 @@ double tNMEA0183Msg::DoubleToddmm(double val) {
   return val;
 }
 
-unsigned long tNMEA0183Msg::TimeTDaysTo1970Offset=tNMEA0183Msg::CalcTimeTDaysTo1970Offset();
+unsigned long tNMEA0183MsgBase::TimeTDaysTo1970Offset=tNMEA0183MsgBase::CalcTimeTDaysTo1970Offset();
 
 //*****************************************************************************
-unsigned long tNMEA0183Msg::elapsedDaysSince1970(time_t dt) {
+unsigned long tNMEA0183MsgBase::elapsedDaysSince1970(time_t dt) {
   unsigned long days=dt/SECS_PER_DAY;
 
   days+=TimeTDaysTo1970Offset;
@@ -447,7 +542,7 @@ unsigned long tNMEA0183Msg::elapsedDaysSince1970(time_t dt) {
 
 #ifndef _Time_h
 //*****************************************************************************
-time_t tNMEA0183Msg::daysToTime_t(unsigned long val) {
+time_t tNMEA0183MsgBase::daysToTime_t(unsigned long val) {
   val-=TimeTDaysTo1970Offset;
 
   return val*SECS_PER_DAY;
@@ -455,7 +550,7 @@ time_t tNMEA0183Msg::daysToTime_t(unsigned long val) {
 #endif
 
 //*****************************************************************************
-unsigned long tNMEA0183Msg::CalcTimeTDaysTo1970Offset() {
+unsigned long tNMEA0183MsgBase::CalcTimeTDaysTo1970Offset() {
   // Need better routine. Now just guess between 1.1.1970 and 1.1.2000
   tmElements_t tme;
   SetYear(tme,2010);
@@ -471,7 +566,7 @@ unsigned long tNMEA0183Msg::CalcTimeTDaysTo1970Offset() {
 }
 
 //*****************************************************************************
-unsigned long tNMEA0183Msg::DaysToNMEA0183Date(unsigned long val) {
+unsigned long tNMEA0183MsgBase::DaysToNMEA0183Date(unsigned long val) {
   if ( val!=NMEA0183UInt32NA  ) {
     tmElements_t tm;
     #ifndef _Time_h
@@ -28,6 +28,10 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <string.h>
 #include <time.h>
 #include "NMEA0183Stream.h"
+#include "NMEA0183TagBlock.h"
+#if !defined(ARDUINO) && __cplusplus>=201703L
+#include <string_view>
+#endif
 
 const double   NMEA0183DoubleNA=-1e9;
 const uint8_t  NMEA0183UInt8NA=0xff;
@@ -49,25 +53,68 @@ inline bool NMEA0183IsNA(int32_t v) { return v==NMEA0183Int32NA; }
 inline bool NMEA0183IsNA(int64_t v) { return v==NMEA0183Int64NA; }
 inline bool NMEA0183IsTimeNA(time_t v) { return v==NMEA0183time_tNA; }
 
+// Packed message code and sender for integer comparisons. Message code is packed
+// big endian to 64 bits, so codes up to 8 characters can be packed. Longer codes
+// get NMEA0183CodeNA, which never matches. E.g. NMEA0183Code("RMC")==0x524d43.
+const uint64_t NMEA0183CodeNA=0xffffffffffffffffULL;
+
+constexpr uint64_t NMEA0183CodePack(const char *code, uint64_t key, uint8_t len) {
+  return ( *code==0?key:( len>=8?NMEA0183CodeNA:NMEA0183CodePack(code+1,(key<<8) | (uint8_t)*code,len+1) ) );
+}
+constexpr uint64_t NMEA0183Code(const char *code) { return NMEA0183CodePack(code,0,0); }
+constexpr uint16_t NMEA0183Sender(const char *sender) {
+  return ( sender[0]==0?0:((uint16_t)(uint8_t)sender[0]<<8) | (uint8_t)sender[1] );
+}
+
+// Default message capacity. Use tNMEA0183MsgT for other capacities.
+#ifndef MAX_NMEA0183_MSG_LEN
 #define MAX_NMEA0183_MSG_LEN 81  // According to NMEA 3.01. Can not contain multi message as in AIS
+#endif
+#ifndef MAX_NMEA0183_MSG_FIELDS
 #define MAX_NMEA0183_MSG_FIELDS 20
+#endif
 
 #ifndef _Time_h
 typedef tm tmElements_t;
 #endif
 
 //------------------------------------------------------------------------------
-class tNMEA0183Msg
+// Field reference with known length. Data is not necessarily null terminated.
+struct tNMEA0183Field
+{
+  const char *Data;
+  size_t Len;
+
+  tNMEA0183Field() : Data(""), Len(0) {}
+  tNMEA0183Field(const char *_Data, size_t _Len) : Data(_Data), Len(_Len) {}
+  bool IsEmpty() const { return Len==0; }
+  bool Equals(const char *str) const { return strlen(str)==Len && memcmp(Data,str,Len)==0; }
+  #if !defined(ARDUINO) && __cplusplus>=201703L
+  operator std::string_view() const { return std::string_view(Data,Len); }
+  #endif
+};
+
+//------------------------------------------------------------------------------
+// Message functionality. Storage for data and fields is provided by tNMEA0183MsgT,
+// so functions taking tNMEA0183MsgBase accept messages with any capacity.
+class tNMEA0183MsgBase
 {
   protected:
     static const char *const EmptyField;
     unsigned long _MessageTime;
-    char Data[MAX_NMEA0183_MSG_LEN];
+    uint64_t _RxTime;
+    char *Data;
+    uint8_t MaxLen;
     uint8_t iAddData;
     char Prefix;
-    uint8_t Fields[MAX_NMEA0183_MSG_FIELDS];
+    uint8_t *Fields;
+    uint8_t *FieldLens;
+    uint8_t MaxFields;
     uint8_t _FieldCount;
     uint8_t CheckSum;
+    uint64_t _MessageCodeKey;
+    uint16_t _SenderKey;
+    tNMEA0183TagBlock _TagBlock;
 
 
 // Helper functions on converting TimeLib.h to time.h
@@ -106,16 +153,40 @@ class tNMEA0183Msg
     static unsigned long elapsedDaysSince1970(time_t dt);
 
   protected:
-    void ForceNullTermination() { Data[MAX_NMEA0183_MSG_LEN-1]=0; } // Just force null termination for data
+    void ForceNullTermination() { Data[MaxLen-1]=0; } // Just force null termination for data
+
+    tNMEA0183MsgBase(char *_Data, uint8_t _MaxLen, uint8_t *_Fields, uint8_t *_FieldLens, uint8_t _MaxFields);
+    tNMEA0183MsgBase(const tNMEA0183MsgBase &)=delete;
+
+  // Incremental message receiving. Received characters are written directly to
+  // Data and checksum and field table are updated on the fly. Used by SetMessage
+  // and tNMEA0183 message framing.
+  protected:
+    friend class tNMEA0183Base;
+    // Start receiving new message with given prefix ('$' or '!').
+    void StartReceive(char _Prefix);
+    // Add received characters between prefix and '*'. Returns false, if message is invalid.
+    bool AddReceived(const char *buf, size_t len);
+    // '*' has been received. Returns false, if message is invalid.
+    bool EndReceiveData();
+    // Received checksum is ready. Returns true, if checksum is OK.
+    bool EndReceive(uint8_t RxCheckSum);
+    // Set message from buf, where DataEnd points to '*' followed by two checksum characters.
+    bool SetReceived(const char *buf, const char *DataEnd);
 
   public:
     uint8_t SourceID;  // This is used to separate messages e.g. from different ports. Receiver must set this.
     static const char *const DefDoubleFormat;
 
   public:
-    tNMEA0183Msg();
+    // Copy message. Returns false and clears message, if Msg does not fit.
+    bool CopyFrom(const tNMEA0183MsgBase &Msg);
+    tNMEA0183MsgBase &operator=(const tNMEA0183MsgBase &Msg) { CopyFrom(Msg); return *this; }
     // Set message from received null terminated buffer. Returns true if checksum is OK.
+    // Message may start with TAG block, which will be parsed to TagBlock().
     bool SetMessage(const char *buf);
+    // Set message from received buffer with length. Buffer does not need to be null terminated.
+    bool SetMessage(const char *buf, size_t len);
     // Get message as complete NMEA0183 format string to buffer.
     bool GetMessage(char *MsgData, size_t BufSize) const;
     // Clear message
@@ -137,10 +208,25 @@ class tNMEA0183Msg
     uint8_t GetCheckSum() const { return CheckSum; }
     // Check is message code given
     bool IsMessageCode(const char* _code) const { return (strcmp(MessageCode(),_code)==0); }
+    // Check is message code given packed with NMEA0183Code. E.g. IsMessageCode(NMEA0183Code("RMC"))
+    bool IsMessageCode(uint64_t _codeKey) const { return _codeKey==_MessageCodeKey && _codeKey!=NMEA0183CodeNA; }
+    // Return message code packed with NMEA0183Code. Can be used e.g. on switch statement.
+    uint64_t MessageCodeKey() const { return _MessageCodeKey; }
+    // Return sender packed with NMEA0183Sender.
+    uint16_t SenderKey() const { return _SenderKey; }
     //
     unsigned long MessageTime() const { return _MessageTime; }
+    // Arrival time of message start character in ns since 1.1.1970 (CLOCK_REALTIME) as
+    // reported by stream or given to Feed. 0, if time is not known. See tNMEA0183Stream::GetReadTime.
+    uint64_t RxTime() const { return _RxTime; }
+    void SetRxTime(uint64_t RxTime) { _RxTime=RxTime; }
+    // Return TAG block received before message. Flags is 0, if there was no TAG block.
+    const tNMEA0183TagBlock &TagBlock() const { return _TagBlock; }
+    void SetTagBlock(const tNMEA0183TagBlock &TagBlock) { _TagBlock=TagBlock; }
     // Return length of field
     unsigned int FieldLen(uint8_t index) const;
+    // Return field with length.
+    tNMEA0183Field FieldView(uint8_t index) const { return ( index<_FieldCount?tNMEA0183Field(Data+Fields[index],FieldLens[index]):tNMEA0183Field() ); }
 
     // Init message building.
     bool Init(const char *_MessageCode, const char *_Sender="II", char _Prefix='$');
@@ -185,6 +271,34 @@ class tNMEA0183Msg
 
     // Helper function to convert days since 1970 to ddmmyyyy.
     static unsigned long DaysToNMEA0183Date(unsigned long val);
+
+    // Helper function to convert checksum hex character to value. Accepts also lower case.
+    static uint8_t HexToNibble(char c) { return (c<=57?c-48:(c<=70?c-55:c-87)); }
 };
 
+//------------------------------------------------------------------------------
+// Message with capacity MsgLen characters and MaxFields fields. Capacity can be
+// at most 255.
+template<uint16_t MsgLen, uint16_t _MaxFields>
+class tNMEA0183MsgT : public tNMEA0183MsgBase
+{
+  static_assert(MsgLen>=16 && MsgLen<=255,"NMEA0183 message length must be 16..255");
+  static_assert(_MaxFields>=1 && _MaxFields<=255,"NMEA0183 message field count must be 1..255");
+
+  protected:
+    char DataBuf[MsgLen];
+    uint8_t FieldsBuf[_MaxFields];
+    uint8_t FieldLensBuf[_MaxFields];
+
+  public:
+    tNMEA0183MsgT() : tNMEA0183MsgBase(DataBuf,MsgLen,FieldsBuf,FieldLensBuf,_MaxFields) { Clear(); }
+    tNMEA0183MsgT(const tNMEA0183MsgT &Msg) : tNMEA0183MsgBase(DataBuf,MsgLen,FieldsBuf,FieldLensBuf,_MaxFields) { CopyFrom(Msg); }
+    explicit tNMEA0183MsgT(const tNMEA0183MsgBase &Msg) : tNMEA0183MsgBase(DataBuf,MsgLen,FieldsBuf,FieldLensBuf,_MaxFields) { CopyFrom(Msg); }
+    tNMEA0183MsgT &operator=(const tNMEA0183MsgT &Msg) { CopyFrom(Msg); return *this; }
+    tNMEA0183MsgT &operator=(const tNMEA0183MsgBase &Msg) { CopyFrom(Msg); return *this; }
+};
+
+// Message with default capacity according to NMEA 3.01.
+typedef tNMEA0183MsgT<MAX_NMEA0183_MSG_LEN,MAX_NMEA0183_MSG_FIELDS> tNMEA0183Msg;
+
 #endif
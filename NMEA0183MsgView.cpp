@@ -0,0 +1,106 @@
+/*
+NMEA0183MsgView.cpp
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#include "NMEA0183MsgView.h"
+
+const char *const tNMEA0183MsgView::EmptyField="";
+
+//*****************************************************************************
+tNMEA0183MsgView::tNMEA0183MsgView() {
+  Clear();
+}
+
+//*****************************************************************************
+void tNMEA0183MsgView::Clear() {
+  SourceID=0;
+  Buf=EmptyField;
+  _FieldCount=0;
+  CheckSum=0;
+  Prefix=' ';
+  Header[0]=0;  // Sender is empty
+  Header[3]=0;  // Message code is empty
+  _MessageCodeKey=0;
+  _SenderKey=0;
+}
+
+//*****************************************************************************
+bool tNMEA0183MsgView::SetMessage(const char *buf, size_t len) {
+  Clear();
+
+  if ( buf==0 || len<1 || (buf[0]!='$' && buf[0]!='!') ) return false; // Invalid message
+
+  size_t i=1;
+  size_t iHeader=0;
+  uint8_t cs=0;
+
+  // Set sender
+  for (; iHeader<2 && i<len; i++, iHeader++) {
+    cs^=buf[i];
+    Header[iHeader]=buf[i];
+  }
+  if ( iHeader<2 ) { Clear(); return false; }
+  Header[iHeader]=0; iHeader++; // null termination for sender
+
+  // Set message code. Read until next comma
+  for (; i<len && buf[i]!=',' && buf[i]!='*' && iHeader<MAX_NMEA0183_MSG_HEADER_LEN-1; i++, iHeader++) {
+    cs^=buf[i];
+    Header[iHeader]=buf[i];
+  }
+  Header[iHeader]=0;
+  if ( i>=len || buf[i]!=',' ) { Clear(); return false; } // No separation after message code -> invalid message
+
+  // Record fields and calculate checksum. Read until '*'
+  for (; i<len && buf[i]!='*'; i++) {
+    cs^=buf[i];
+    if ( buf[i]==',' ) { // New field
+      if ( _FieldCount>0 ) FieldLens[_FieldCount-1]=i-Fields[_FieldCount-1];
+      if ( _FieldCount>=MAX_NMEA0183_MSG_FIELDS || i+1>UINT16_MAX ) { Clear(); return false; }
+      Fields[_FieldCount]=i+1;
+      _FieldCount++;
+    }
+  }
+
+  if ( i+2>=len || buf[i]!='*' ) { Clear(); return false; } // No checksum -> invalid message
+  FieldLens[_FieldCount-1]=i-Fields[_FieldCount-1];
+
+  uint8_t csMsg=(tNMEA0183MsgBase::HexToNibble(buf[i+1])<<4) | tNMEA0183MsgBase::HexToNibble(buf[i+2]);
+  if ( csMsg!=cs ) { Clear(); return false; }
+
+  Buf=buf;
+  Prefix=buf[0];
+  CheckSum=cs;
+  _MessageCodeKey=NMEA0183Code(MessageCode());
+  _SenderKey=NMEA0183Sender(Sender());
+
+  return true;
+}
+
+//*****************************************************************************
+const char *tNMEA0183MsgView::Field(uint8_t index) const {
+  if ( index<_FieldCount && FieldLens[index]>0 ) {
+    return Buf+Fields[index];
+  } else {
+    return EmptyField;
+  }
+}
@@ -0,0 +1,90 @@
+/*
+NMEA0183MsgView.h
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+Read only view to NMEA0183 message in caller owned buffer. Message data will not
+be copied. View only records field positions and lengths in buffer, so buffer
+must stay valid as long as view is used. View can be used with all
+NMEA0183Parse* functions.
+*/
+
+#ifndef _tNMEA0183MsgView_H_
+#define _tNMEA0183MsgView_H_
+
+#include "NMEA0183Msg.h"
+
+#define MAX_NMEA0183_MSG_HEADER_LEN 14  // Sender, message code and null terminations
+
+//------------------------------------------------------------------------------
+class tNMEA0183MsgView
+{
+  protected:
+    static const char *const EmptyField;
+    const char *Buf;  // Buffer given on SetMessage
+    uint16_t Fields[MAX_NMEA0183_MSG_FIELDS];    // Field start positions in Buf
+    uint16_t FieldLens[MAX_NMEA0183_MSG_FIELDS];
+    uint8_t _FieldCount;
+    char Prefix;
+    uint8_t CheckSum;
+    uint64_t _MessageCodeKey;
+    uint16_t _SenderKey;
+    // Sender and message code are short, so they are copied null terminated for
+    // compatibility with tNMEA0183Msg.
+    char Header[MAX_NMEA0183_MSG_HEADER_LEN];
+
+  public:
+    uint8_t SourceID;  // This is used to separate messages e.g. from different ports. Receiver must set this.
+
+  public:
+    tNMEA0183MsgView();
+    // Set view to message in buf. Buffer does not need to be null terminated
+    // and it may have CR/LF after checksum. Returns true if checksum is OK.
+    bool SetMessage(const char *buf, size_t len);
+    bool SetMessage(const char *buf) { return SetMessage(buf,(buf!=0?strlen(buf):0)); }
+    // Clear view
+    void Clear();
+    // Return count of fields on message
+    uint8_t FieldCount() const { return _FieldCount; }
+    // Return start of field. Note that field is not null terminated. It ends
+    // to ',' or '*', so use FieldLen. For empty field returns empty string.
+    const char *Field(uint8_t index) const;
+    // Return length of field
+    unsigned int FieldLen(uint8_t index) const { return ( index<_FieldCount?FieldLens[index]:0 ); }
+    // Return field with length.
+    tNMEA0183Field FieldView(uint8_t index) const { return ( index<_FieldCount?tNMEA0183Field(Field(index),FieldLens[index]):tNMEA0183Field() ); }
+    char GetPrefix() const { return Prefix; }
+    // Return sender code (like GP) in null terminated string
+    const char *Sender() const { return Header; }
+    // Return message code (like GGA) in null terminated string
+    const char *MessageCode() const { return Header+3; }
+    // Return checksum of message.
+    uint8_t GetCheckSum() const { return CheckSum; }
+    // Check is message code given
+    bool IsMessageCode(const char* _code) const { return (strcmp(MessageCode(),_code)==0); }
+    // Check is message code given packed with NMEA0183Code.
+    bool IsMessageCode(uint64_t _codeKey) const { return _codeKey==_MessageCodeKey && _codeKey!=NMEA0183CodeNA; }
+    // Return message code packed with NMEA0183Code.
+    uint64_t MessageCodeKey() const { return _MessageCodeKey; }
+    // Return sender packed with NMEA0183Sender.
+    uint16_t SenderKey() const { return _SenderKey; }
+};
+
+#endif
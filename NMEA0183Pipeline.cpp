@@ -0,0 +1,85 @@
+/*
+NMEA0183Pipeline.cpp
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#ifndef ARDUINO
+#include "NMEA0183Pipeline.h"
+#include "NMEA0183Scan.h"
+
+//*****************************************************************************
+void tNMEA0183SentenceSplitter::Split(const char *data, size_t len, const std::function<void(const char *Sentence, size_t Len)> &Sentence) {
+  const char *end=data+len;
+
+  while ( data<end ) {
+    switch ( State ) {
+      case ssNone:
+        data=NMEA0183FindMsgStart(data,end);
+        if ( data==end ) break;
+        Len=0;
+        Buf[Len++]=*data;
+        State=( *data=='\\'?ssTag:ssData );
+        data++;
+        break;
+      case ssTag: {
+          const char *p=data;
+          for (; p<end && *p!='\\' && *p!='$' && *p!='!'; p++);
+          if ( !Add(data,p-data) ) break;
+          data=p;
+          if ( p==end ) break;
+          if ( *p!='\\' ) { State=ssNone; break; } // Message start inside TAG block. Restart from it.
+          Add(p,1);
+          data++;
+          State=ssTagEnd;
+        }
+        break;
+      case ssTagEnd:
+        if ( *data!='$' && *data!='!' ) { State=ssNone; break; }
+        Add(data,1);
+        data++;
+        State=ssData;
+        break;
+      case ssData: {
+          const char *p=NMEA0183FindMsgDelimiter(data,end);
+          if ( !Add(data,p-data) ) break;
+          data=p;
+          if ( p==end ) break;
+          if ( *p!='*' ) { State=ssNone; break; } // New message started before checksum
+          Add(p,1);
+          data++;
+          CheckSumChars=0;
+          State=ssCheckSum;
+        }
+        break;
+      case ssCheckSum:
+        if ( !Add(data,1) ) break;
+        data++;
+        if ( ++CheckSumChars==2 ) {
+          Sentence(Buf,Len);
+          State=ssNone;
+        }
+        break;
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,249 @@
+/*
+NMEA0183Pipeline.h
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+Multithreaded message pipeline for servers handling many feeds. Thread calling
+Feed only splits data to sentences. Worker threads validate checksum, split
+fields and decode messages with user decoder e.g. calling NMEA0183Parse*
+functions. Results are delivered to handler on thread calling Feed, Poll or
+Flush in same order as sentences were fed.
+
+Not available on Arduino.
+*/
+
+#ifndef _NMEA0183PIPELINE_H_
+#define _NMEA0183PIPELINE_H_
+
+#ifndef ARDUINO
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <string.h>
+#include "NMEA0183Msg.h"
+#include "NMEA0183TagBlock.h"
+
+#define MAX_NMEA0183_SENTENCE_LEN (MAX_NMEA0183_TAG_LEN+4+MAX_NMEA0183_MSG_LEN+3)
+
+//------------------------------------------------------------------------------
+// Splits received data to sentences including optional TAG block without
+// checking checksum. Sentence ends to checksum. Incomplete sentence at end of
+// data is continued on next call.
+class tNMEA0183SentenceSplitter
+{
+  protected:
+    enum tState { ssNone, ssTag, ssTagEnd, ssData, ssCheckSum };
+    char Buf[MAX_NMEA0183_SENTENCE_LEN];
+    size_t Len;
+    uint8_t State;
+    uint8_t CheckSumChars;
+
+    bool Add(const char *data, size_t len) {
+      if ( Len+len>sizeof(Buf) ) { State=ssNone; return false; } // Too long, drop sentence
+      memcpy(Buf+Len,data,len);
+      Len+=len;
+      return true;
+    }
+
+  public:
+    tNMEA0183SentenceSplitter() : Len(0), State(ssNone), CheckSumChars(0) {}
+    // Split data and call Sentence for each complete sentence. Sentence is valid
+    // only during call.
+    void Split(const char *data, size_t len, const std::function<void(const char *Sentence, size_t Len)> &Sentence);
+};
+
+// Default result for pipeline without own decoder result.
+struct tNMEA0183NoResult {};
+
+//------------------------------------------------------------------------------
+// Pipeline with decoder result type tResult. Decoder fills result on worker
+// thread. Handler gets message and result on thread calling Feed, Poll or Flush.
+template<class tResult=tNMEA0183NoResult>
+class tNMEA0183Pipeline
+{
+  public:
+    struct tItem {
+      tNMEA0183Msg Msg;
+      tResult Result;
+      bool Valid;     // Checksum and format OK
+      bool Decoded;   // Decoder returned true
+      uint8_t SourceID;
+      uint16_t RawLen;
+      char Raw[MAX_NMEA0183_SENTENCE_LEN];
+    };
+    typedef std::function<bool(const tNMEA0183Msg &Msg, tResult &Result)> tDecoder;
+    typedef std::function<void(const tNMEA0183Msg &Msg, const tResult &Result, bool Decoded)> tHandler;
+
+  protected:
+    // Work unit. Sentences fed on one Feed call are handled on same chunk, so
+    // locking cost is shared by them.
+    struct tChunk {
+      std::vector<tItem> Items;
+      size_t Count;
+      bool Done;
+    };
+
+    tDecoder Decoder;
+    tHandler Handler;
+    std::vector<tChunk> Chunks;  // Reorder ring. Delivered in order from ChunkTail.
+    size_t ChunkHead;
+    size_t ChunkTail;
+    std::vector<tNMEA0183SentenceSplitter> Splitters; // One for each source
+    std::vector<std::thread> Workers;
+    std::mutex Lock;
+    std::condition_variable WorkAvailable;
+    std::condition_variable ChunkDone;
+    std::deque<tChunk *> WorkQueue;
+    bool Stopping;
+    uint32_t Errors;
+
+    void Worker() {
+      for (;;) {
+        tChunk *Chunk;
+        {
+          std::unique_lock<std::mutex> lk(Lock);
+          WorkAvailable.wait(lk,[this]() { return Stopping || !WorkQueue.empty(); });
+          if ( WorkQueue.empty() ) return;
+          Chunk=WorkQueue.front();
+          WorkQueue.pop_front();
+        }
+        for ( size_t i=0; i<Chunk->Count; i++ ) {
+          tItem &Item=Chunk->Items[i];
+          Item.Decoded=false;
+          Item.Valid=Item.Msg.SetMessage(Item.Raw,Item.RawLen);
+          if ( !Item.Valid ) continue;
+          Item.Msg.SourceID=Item.SourceID;
+          Item.Decoded=( Decoder?Decoder(Item.Msg,Item.Result):true );
+        }
+        {
+          std::lock_guard<std::mutex> lk(Lock);
+          Chunk->Done=true;
+        }
+        ChunkDone.notify_all();
+      }
+    }
+
+    // Deliver completed chunks in order. If Wait is set, wait all chunks.
+    void Deliver(bool Wait) {
+      while ( ChunkTail!=ChunkHead ) {
+        tChunk &Chunk=Chunks[ChunkTail % Chunks.size()];
+        {
+          std::unique_lock<std::mutex> lk(Lock);
+          if ( !Chunk.Done ) {
+            if ( !Wait ) return;
+            ChunkDone.wait(lk,[&Chunk]() { return Chunk.Done; });
+          }
+        }
+        for ( size_t i=0; i<Chunk.Count; i++ ) {
+          tItem &Item=Chunk.Items[i];
+          if ( !Item.Valid ) { Errors++; continue; }
+          if ( Handler ) Handler(Item.Msg,Item.Result,Item.Decoded);
+        }
+        ChunkTail++;
+      }
+    }
+
+    tChunk &NewChunk() {
+      if ( ChunkHead-ChunkTail==Chunks.size() ) { // All chunks in use. Wait oldest.
+        tChunk &Oldest=Chunks[ChunkTail % Chunks.size()];
+        {
+          std::unique_lock<std::mutex> lk(Lock);
+          ChunkDone.wait(lk,[&Oldest]() { return Oldest.Done; });
+        }
+        Deliver(false);
+      }
+      tChunk &Chunk=Chunks[ChunkHead % Chunks.size()];
+      Chunk.Count=0;
+      Chunk.Done=false;
+      return Chunk;
+    }
+
+    void Submit(tChunk &Chunk) {
+      {
+        std::lock_guard<std::mutex> lk(Lock);
+        WorkQueue.push_back(&Chunk);
+      }
+      ChunkHead++;
+      WorkAvailable.notify_one();
+    }
+
+  public:
+    // Start pipeline with Threads workers. 0 uses hardware concurrency. ChunkSize
+    // is max sentences on one work unit and MaxChunks max work units on flight.
+    tNMEA0183Pipeline(tDecoder _Decoder, tHandler _Handler, size_t Threads=0, size_t ChunkSize=64, size_t MaxChunks=0)
+      : Decoder(_Decoder), Handler(_Handler), ChunkHead(0), ChunkTail(0), Splitters(256), Stopping(false), Errors(0) {
+      if ( Threads==0 ) Threads=std::thread::hardware_concurrency();
+      if ( Threads==0 ) Threads=1;
+      if ( ChunkSize==0 ) ChunkSize=1;
+      if ( MaxChunks==0 ) MaxChunks=4*Threads;
+      Chunks.resize(MaxChunks);
+      for ( size_t i=0; i<MaxChunks; i++ ) Chunks[i].Items.resize(ChunkSize);
+      for ( size_t i=0; i<Threads; i++ ) Workers.push_back(std::thread(&tNMEA0183Pipeline::Worker,this));
+    }
+    ~tNMEA0183Pipeline() {
+      {
+        std::lock_guard<std::mutex> lk(Lock);
+        Stopping=true;
+      }
+      WorkAvailable.notify_all();
+      for ( size_t i=0; i<Workers.size(); i++ ) Workers[i].join();
+    }
+    tNMEA0183Pipeline(const tNMEA0183Pipeline &)=delete;
+    tNMEA0183Pipeline &operator=(const tNMEA0183Pipeline &)=delete;
+
+    // Feed received data from source. Each source has own splitter, so data
+    // from different sources can be fed in any order. Completed results will be
+    // delivered. Returns count of sentences found.
+    size_t Feed(uint8_t SourceID, const char *data, size_t len) {
+      size_t SentenceCount=0;
+      tChunk *Chunk=0;
+
+      Splitters[SourceID].Split(data,len,[&](const char *Sentence, size_t SentenceLen) {
+        if ( Chunk==0 ) Chunk=&NewChunk();
+        tItem &Item=Chunk->Items[Chunk->Count++];
+        memcpy(Item.Raw,Sentence,SentenceLen);
+        Item.RawLen=SentenceLen;
+        Item.SourceID=SourceID;
+        SentenceCount++;
+        if ( Chunk->Count==Chunk->Items.size() ) {
+          Submit(*Chunk);
+          Chunk=0;
+        }
+      });
+      if ( Chunk!=0 ) Submit(*Chunk);
+      Deliver(false);
+
+      return SentenceCount;
+    }
+    // Deliver completed results without waiting.
+    void Poll() { Deliver(false); }
+    // Wait until all fed sentences have been handled and delivered.
+    void Flush() { Deliver(true); }
+    // Count of sentences with invalid checksum or format.
+    uint32_t GetErrors() const { return Errors; }
+};
+
+#endif
+
+#endif
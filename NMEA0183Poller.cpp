@@ -0,0 +1,169 @@
+/*
+NMEA0183Poller.cpp
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#if defined(__linux__)||defined(__linux)||defined(linux)
+
+#include <unistd.h>
+#include <sys/epoll.h>
+#include "NMEA0183Poller.h"
+
+// epoll user data has port index and flag for registration of separate write descriptor.
+#define NMEA0183_POLLER_WRITE_FLAG 1
+
+//*****************************************************************************
+tNMEA0183Poller::tNMEA0183Poller(size_t _MaxPorts) : MaxPorts(_MaxPorts) {
+  EpollFd=epoll_create1(EPOLL_CLOEXEC);
+  Ports=new tPort[MaxPorts];
+  for ( size_t i=0; i<MaxPorts; i++ ) {
+    Ports[i].NMEA0183=0;
+    Ports[i].OwnStream=0;
+  }
+}
+
+//*****************************************************************************
+tNMEA0183Poller::~tNMEA0183Poller() {
+  for ( size_t i=0; i<MaxPorts; i++ ) ReleasePort(Ports[i]);
+  delete[] Ports;
+  if ( EpollFd!=-1 ) close(EpollFd);
+}
+
+//*****************************************************************************
+bool tNMEA0183Poller::Add(tNMEA0183Base *NMEA0183, tReadPort _ReadPort, tNMEA0183LinuxStream *OwnStream) {
+  if ( EpollFd==-1 || NMEA0183==0 || !NMEA0183->Open() ) return false;
+
+  int ReadFd=NMEA0183->GetReadFd();
+  if ( ReadFd==-1 ) return false;
+
+  size_t i;
+  for ( i=0; i<MaxPorts && Ports[i].NMEA0183!=0; i++ );
+  if ( i==MaxPorts ) return false;
+
+  tPort &Port=Ports[i];
+  Port.NMEA0183=NMEA0183;
+  Port.ReadPort=_ReadPort;
+  Port.ReadFd=ReadFd;
+  Port.WriteFd=NMEA0183->GetWriteFd();
+  Port.OwnStream=OwnStream;
+
+  struct epoll_event ev;
+  ev.events=EPOLLIN | EPOLLET;
+  if ( Port.WriteFd==ReadFd ) ev.events|=EPOLLOUT;
+  ev.data.u64=i<<1;
+  bool result=( epoll_ctl(EpollFd,EPOLL_CTL_ADD,ReadFd,&ev)==0 );
+  if ( result && Port.WriteFd!=-1 && Port.WriteFd!=ReadFd ) {
+    ev.events=EPOLLOUT | EPOLLET;
+    ev.data.u64=(i<<1) | NMEA0183_POLLER_WRITE_FLAG;
+    result=( epoll_ctl(EpollFd,EPOLL_CTL_ADD,Port.WriteFd,&ev)==0 );
+    if ( !result ) epoll_ctl(EpollFd,EPOLL_CTL_DEL,ReadFd,0);
+  }
+  if ( !result ) {
+    Port.NMEA0183=0;
+    Port.OwnStream=0;
+    return false;
+  }
+
+  // Edge triggered registration does not report data received before it.
+  Port.ReadPort(NMEA0183);
+  return true;
+}
+
+//*****************************************************************************
+tNMEA0183 *tNMEA0183Poller::AddPort(const char *Device, uint8_t SourceID) {
+  tNMEA0183LinuxStream *Stream=new tNMEA0183LinuxStream(Device);
+  if ( !Stream->IsOpen() ) {
+    delete Stream;
+    return 0;
+  }
+
+  tNMEA0183 *NMEA0183=new tNMEA0183(Stream,SourceID);
+  if ( !Add(NMEA0183,&ReadPort<tNMEA0183>,Stream) ) {
+    delete NMEA0183;
+    delete Stream;
+    return 0;
+  }
+
+  return NMEA0183;
+}
+
+//*****************************************************************************
+void tNMEA0183Poller::ReleasePort(tPort &Port) {
+  if ( Port.NMEA0183==0 ) return;
+
+  epoll_ctl(EpollFd,EPOLL_CTL_DEL,Port.ReadFd,0);
+  if ( Port.WriteFd!=-1 && Port.WriteFd!=Port.ReadFd ) epoll_ctl(EpollFd,EPOLL_CTL_DEL,Port.WriteFd,0);
+  if ( Port.OwnStream!=0 ) {
+    delete static_cast<tNMEA0183 *>(Port.NMEA0183);
+    delete Port.OwnStream;
+  }
+  Port.NMEA0183=0;
+  Port.OwnStream=0;
+}
+
+//*****************************************************************************
+bool tNMEA0183Poller::Remove(tNMEA0183Base *NMEA0183) {
+  for ( size_t i=0; i<MaxPorts; i++ ) {
+    if ( Ports[i].NMEA0183==NMEA0183 && NMEA0183!=0 ) {
+      ReleasePort(Ports[i]);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+//*****************************************************************************
+size_t tNMEA0183Poller::Poll(int TimeoutMs) {
+  struct epoll_event Events[MAX_NMEA0183_POLLER_EVENTS];
+  size_t MsgCount=0;
+
+  int n=epoll_wait(EpollFd,Events,MAX_NMEA0183_POLLER_EVENTS,TimeoutMs);
+
+  for ( int e=0; e<n; e++ ) {
+    size_t i=Events[e].data.u64>>1;
+    if ( i>=MaxPorts ) continue;
+    tPort &Port=Ports[i];
+    if ( Port.NMEA0183==0 ) continue; // Port has been removed
+
+    if ( !(Events[e].data.u64 & NMEA0183_POLLER_WRITE_FLAG) &&
+         (Events[e].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) ) {
+      MsgCount+=Port.ReadPort(Port.NMEA0183);
+    }
+    if ( (Events[e].events & EPOLLOUT) && Port.NMEA0183!=0 && Port.NMEA0183->HasPendingOutput() ) {
+      Port.NMEA0183->OnWritable();
+    }
+  }
+
+  return MsgCount;
+}
+
+//*****************************************************************************
+size_t tNMEA0183Poller::PortCount() const {
+  size_t Count=0;
+
+  for ( size_t i=0; i<MaxPorts; i++ ) if ( Ports[i].NMEA0183!=0 ) Count++;
+
+  return Count;
+}
+
+#endif
@@ -0,0 +1,92 @@
+/*
+NMEA0183Poller.h
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+Waits many tNMEA0183 ports at once with epoll(7) and reads only ports, which
+have data. Ports are registered edge triggered for read and write, so waiting
+and handling cost depends on traffic, not on count of ports. Each port keeps
+its own SourceID, which will be set to received messages.
+
+Only for Linux.
+*/
+
+#ifndef _NMEA0183POLLER_H_
+#define _NMEA0183POLLER_H_
+
+#if defined(__linux__)||defined(__linux)||defined(linux)
+#include "NMEA0183.h"
+#include "NMEA0183LinuxStream.h"
+
+#define MAX_NMEA0183_POLLER_EVENTS 32 // Events handled on one epoll_wait
+
+//------------------------------------------------------------------------------
+class tNMEA0183Poller
+{
+  protected:
+    typedef size_t (*tReadPort)(tNMEA0183Base *NMEA0183);
+    struct tPort {
+      tNMEA0183Base *NMEA0183;     // 0 for free slot
+      tReadPort ReadPort;          // Calls OnReadable of typed tNMEA0183T
+      int ReadFd;
+      int WriteFd;
+      tNMEA0183LinuxStream *OwnStream; // Stream and NMEA0183 created by AddPort
+    };
+
+    int EpollFd;
+    tPort *Ports;
+    size_t MaxPorts;
+
+    template<class tNMEA0183Type>
+    static size_t ReadPort(tNMEA0183Base *NMEA0183) { return static_cast<tNMEA0183Type *>(NMEA0183)->OnReadable(); }
+    bool Add(tNMEA0183Base *NMEA0183, tReadPort _ReadPort, tNMEA0183LinuxStream *OwnStream);
+    void ReleasePort(tPort &Port);
+
+  public:
+    tNMEA0183Poller(size_t _MaxPorts=16);
+    ~tNMEA0183Poller();
+    tNMEA0183Poller(const tNMEA0183Poller &)=delete;
+    tNMEA0183Poller &operator=(const tNMEA0183Poller &)=delete;
+
+    // Add opened port to poller. Port stream must have descriptor and it should be
+    // non blocking. Returns false, if there is no room or port can not be waited.
+    // Descriptor is read on Add, so port, whose descriptor changes (e.g. reconnecting
+    // tNMEA0183TcpClientStream), must be removed and added again after change.
+    template<uint16_t MsgLen, uint16_t MaxFields>
+    bool Add(tNMEA0183T<MsgLen,MaxFields> *NMEA0183) {
+      return Add(NMEA0183,&ReadPort<tNMEA0183T<MsgLen,MaxFields> >,0);
+    }
+    // Open device and add it as port owned by poller. Returns created tNMEA0183 for
+    // setting handlers or 0 on failure.
+    tNMEA0183 *AddPort(const char *Device, uint8_t SourceID);
+    // Remove port from poller. Port added with AddPort will be deleted, so do not
+    // call this from message handler of the port.
+    bool Remove(tNMEA0183Base *NMEA0183);
+    // Wait up to TimeoutMs (-1 forever) for ready ports, read them and send their
+    // buffered messages. Message handlers of ports are called for received messages.
+    // Returns count of received messages.
+    size_t Poll(int TimeoutMs);
+    // Count of ports on poller.
+    size_t PortCount() const;
+};
+
+#endif
+
+#endif
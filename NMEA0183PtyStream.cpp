@@ -0,0 +1,62 @@
+/*
+NMEA0183PtyStream.cpp
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#if defined(__linux__)||defined(__linux)||defined(linux)
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <termios.h>
+#include "NMEA0183PtyStream.h"
+
+//*****************************************************************************
+tNMEA0183PtyStream::tNMEA0183PtyStream() : PeerFd(-1) {
+  struct termios tio;
+
+  PeerName[0]=0;
+  Bridge=false;  // Failed pty must not fall back to stdin and stdout
+  port=posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+  if ( port==-1 ) return;
+
+  if ( grantpt(port)!=0 || unlockpt(port)!=0 ||
+       ptsname_r(port,PeerName,sizeof(PeerName))!=0 ||
+       (PeerFd=open(PeerName,O_RDWR | O_NOCTTY | O_NONBLOCK))==-1 ||
+       tcgetattr(PeerFd,&tio)!=0 ) {
+    close(port);
+    port=-1;
+    PeerName[0]=0;
+    return;
+  }
+
+  // Raw mode: no echo and CR LF passes unchanged.
+  cfmakeraw(&tio);
+  tcsetattr(PeerFd,TCSANOW,&tio);
+}
+
+//*****************************************************************************
+tNMEA0183PtyStream::~tNMEA0183PtyStream() {
+  if ( PeerFd!=-1 ) close(PeerFd);
+}
+
+#endif
@@ -0,0 +1,54 @@
+/*
+NMEA0183PtyStream.h
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+Pseudo terminal stream for Linux. Stream is master side of new pty pair set to
+raw mode. Peer device (e.g. /dev/pts/3) can be opened with tNMEA0183SerialStream
+or by other program, so that serial port code can be tested and benchmarked
+without hardware. Stream keeps peer open itself, so master side can be read and
+written also when peer has not been opened or has been closed.
+*/
+
+#ifndef _NMEA0183_PTY_STREAM_H_
+#define _NMEA0183_PTY_STREAM_H_
+
+#include "NMEA0183LinuxStream.h"
+
+#if defined(__linux__)||defined(__linux)||defined(linux)
+
+#define MAX_NMEA0183_PTY_NAME_LEN 64
+
+//-----------------------------------------------------------------------------
+class tNMEA0183PtyStream : public tNMEA0183LinuxStream {
+protected:
+  int PeerFd;
+  char PeerName[MAX_NMEA0183_PTY_NAME_LEN];
+
+public:
+  // Create pty pair. Use IsOpen to check was it created.
+  tNMEA0183PtyStream();
+  virtual ~tNMEA0183PtyStream();
+  // Device name of peer side or empty string, if pty could not be created.
+  const char *GetPeerName() const { return PeerName; }
+};
+#endif
+
+#endif /* _NMEA0183_PTY_STREAM_H_ */
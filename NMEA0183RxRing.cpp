@@ -0,0 +1,52 @@
+/*
+NMEA0183RxRing.cpp
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#include <string.h>
+#include "NMEA0183RxRing.h"
+
+//*****************************************************************************
+tNMEA0183RxRing::tNMEA0183RxRing(char *_Buf, size_t Size)
+: Buf(_Buf), Mask(Size-1), Head(0), Tail(0), Overruns(0) {
+}
+
+//*****************************************************************************
+// Copy in at most two parts around end of buffer and publish all at once.
+size_t tNMEA0183RxRing::Push(const char *data, size_t len) {
+  size_t h=Head;
+  size_t Free=Mask+1-(h-LoadAcquire(Tail));
+
+  if ( len>Free ) {
+    Overruns+=len-Free;
+    len=Free;
+  }
+
+  size_t i=h & Mask;
+  size_t n=Mask+1-i;
+  if ( n>len ) n=len;
+  memcpy(Buf+i,data,n);
+  memcpy(Buf,data+n,len-n);
+  StoreRelease(Head,h+len);
+
+  return len;
+}
@@ -0,0 +1,124 @@
+/*
+NMEA0183RxRing.h
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+Lock free single producer single consumer receive ring. Producer is e.g. UART
+interrupt or reader thread and consumer tNMEA0183, which parses data directly
+from ring memory. Indexes run freely and are masked on access, so size must be
+power of 2. Producer only writes Head and consumer only writes Tail.
+*/
+
+#ifndef _NMEA0183RXRING_H_
+#define _NMEA0183RXRING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#ifndef __GNUC__
+#include <atomic>
+#endif
+
+//------------------------------------------------------------------------------
+class tNMEA0183RxRing
+{
+  protected:
+    char *Buf;
+    size_t Mask;
+    size_t Head;  // Next write position. Written only by producer.
+    size_t Tail;  // Next read position. Written only by consumer.
+    uint32_t Overruns; // Bytes dropped, because ring was full. Written only by producer.
+
+    static inline size_t LoadAcquire(const size_t &v) {
+      #ifdef __GNUC__
+      return __atomic_load_n(&v,__ATOMIC_ACQUIRE);
+      #else
+      size_t r=*(const volatile size_t *)&v;
+      std::atomic_thread_fence(std::memory_order_acquire);
+      return r;
+      #endif
+    }
+    static inline void StoreRelease(size_t &v, size_t val) {
+      #ifdef __GNUC__
+      __atomic_store_n(&v,val,__ATOMIC_RELEASE);
+      #else
+      std::atomic_thread_fence(std::memory_order_release);
+      *(volatile size_t *)&v=val;
+      #endif
+    }
+
+  public:
+    // Size must be power of 2.
+    tNMEA0183RxRing(char *_Buf, size_t Size);
+
+    // Producer side. Call only from one ISR or thread.
+    // Add byte to ring. Returns false, if ring is full.
+    inline bool Push(char c) {
+      size_t h=Head;
+      if ( h-LoadAcquire(Tail)>Mask ) { Overruns++; return false; }
+      Buf[h & Mask]=c;
+      StoreRelease(Head,h+1);
+      return true;
+    }
+    // Add bytes to ring. Returns count of bytes added. Rest are dropped.
+    size_t Push(const char *data, size_t len);
+    uint32_t GetOverruns() const { return Overruns; }
+    // Return count of bytes, which can be added without dropping.
+    size_t Free() const { return Mask+1-(Head-LoadAcquire(Tail)); }
+
+    // Consumer side. Call only from one thread.
+    // Return count of bytes available.
+    size_t Available() const { return LoadAcquire(Head)-Tail; }
+    // Set data to first available byte and return count of contiguous bytes
+    // available from it. Call Consume after data has been handled.
+    size_t ReadSpan(const char *&data) const {
+      size_t t=Tail;
+      size_t n=LoadAcquire(Head)-t;
+      size_t i=t & Mask;
+      if ( n>Mask+1-i ) n=Mask+1-i;
+      data=Buf+i;
+      return n;
+    }
+    // Release n bytes returned by ReadSpan back to producer.
+    void Consume(size_t n) { StoreRelease(Tail,Tail+n); }
+    // Read single byte. Returns -1, if ring is empty.
+    int Read() {
+      const char *data;
+      if ( ReadSpan(data)==0 ) return -1;
+      int c=(uint8_t)*data;
+      Consume(1);
+      return c;
+    }
+};
+
+//------------------------------------------------------------------------------
+// Ring with own storage of Size bytes.
+template<size_t Size>
+class tNMEA0183RxRingT : public tNMEA0183RxRing
+{
+  static_assert(Size>=2 && (Size & (Size-1))==0,"NMEA0183 receive ring size must be power of 2");
+
+  protected:
+    char Storage[Size];
+
+  public:
+    tNMEA0183RxRingT() : tNMEA0183RxRing(Storage,Size) {}
+};
+
+#endif
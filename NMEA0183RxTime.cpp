@@ -0,0 +1,70 @@
+/*
+NMEA0183RxTime.cpp
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#if defined(__linux__)||defined(__linux)||defined(linux)
+
+#include "NMEA0183RxTime.h"
+
+//*****************************************************************************
+bool NMEA0183EnableRxTime(int fd) {
+  int On=1;
+  return setsockopt(fd,SOL_SOCKET,SO_TIMESTAMPNS,&On,sizeof(On))==0;
+}
+
+//*****************************************************************************
+uint64_t NMEA0183GetRxTime(const struct msghdr *msg) {
+  for ( struct cmsghdr *cmsg=CMSG_FIRSTHDR(msg); cmsg!=0; cmsg=CMSG_NXTHDR((struct msghdr *)msg,cmsg) ) {
+    if ( cmsg->cmsg_level==SOL_SOCKET && cmsg->cmsg_type==SCM_TIMESTAMPNS ) {
+      const struct timespec *ts=(const struct timespec *)CMSG_DATA(cmsg);
+      return (uint64_t)ts->tv_sec*1000000000ULL+ts->tv_nsec;
+    }
+  }
+
+  return NMEA0183RealTimeNs();
+}
+
+//*****************************************************************************
+ssize_t NMEA0183RecvTimed(int fd, void *buf, size_t len, int flags, uint64_t &RxTime) {
+  struct iovec iov={buf,len};
+  struct msghdr msg;
+  union { // Aligned control buffer
+    char Buf[NMEA0183_RX_TIME_CONTROL_LEN];
+    struct cmsghdr Align;
+  } Control;
+
+  msg.msg_name=0;
+  msg.msg_namelen=0;
+  msg.msg_iov=&iov;
+  msg.msg_iovlen=1;
+  msg.msg_control=Control.Buf;
+  msg.msg_controllen=sizeof(Control.Buf);
+  msg.msg_flags=0;
+
+  ssize_t n=recvmsg(fd,&msg,flags);
+  if ( n>0 ) RxTime=NMEA0183GetRxTime(&msg);
+
+  return n;
+}
+
+#endif
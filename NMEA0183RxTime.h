@@ -0,0 +1,60 @@
+/*
+NMEA0183RxTime.h
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+Receive time helpers for Linux. Sockets are asked to timestamp received data
+in kernel (SO_TIMESTAMPNS), so that time does not include delays of user space
+buffering and parsing. All times are ns since 1.1.1970 (CLOCK_REALTIME), which
+is also clock of kernel socket timestamps.
+*/
+
+#ifndef _NMEA0183RXTIME_H_
+#define _NMEA0183RXTIME_H_
+
+#if defined(__linux__)||defined(__linux)||defined(linux)
+#include <stdint.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+
+// Control buffer size needed for one receive timestamp.
+#define NMEA0183_RX_TIME_CONTROL_LEN CMSG_SPACE(sizeof(struct timespec))
+
+// Current time in ns since 1.1.1970.
+inline uint64_t NMEA0183RealTimeNs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_REALTIME,&ts);
+  return (uint64_t)ts.tv_sec*1000000000ULL+ts.tv_nsec;
+}
+
+// Enable kernel receive timestamps on socket. Returns false, if socket does not support them.
+bool NMEA0183EnableRxTime(int fd);
+
+// Return kernel receive timestamp from control data of received message, or
+// current time, if message does not have timestamp.
+uint64_t NMEA0183GetRxTime(const struct msghdr *msg);
+
+// recv(2) with kernel receive timestamp. RxTime is set, when data was received.
+ssize_t NMEA0183RecvTimed(int fd, void *buf, size_t len, int flags, uint64_t &RxTime);
+
+#endif
+
+#endif
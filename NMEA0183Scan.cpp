@@ -0,0 +1,113 @@
+/*
+NMEA0183Scan.cpp
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#include "NMEA0183Scan.h"
+
+#if !defined(ARDUINO) && defined(__GNUC__) && ( defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__)) )
+#define NMEA0183_SCAN_X86
+#include <immintrin.h>
+#endif
+
+typedef const char *(*tNMEA0183ScanFunc)(const char *buf, const char *end, char c1, char c2, char c3);
+
+//*****************************************************************************
+static const char *ScanScalar(const char *buf, const char *end, char c1, char c2, char c3) {
+  for ( ; buf<end; buf++ ) {
+    if ( *buf==c1 || *buf==c2 || *buf==c3 ) return buf;
+  }
+
+  return end;
+}
+
+#ifdef NMEA0183_SCAN_X86
+//*****************************************************************************
+static const char *ScanSSE2(const char *buf, const char *end, char c1, char c2, char c3) {
+  const __m128i v1=_mm_set1_epi8(c1);
+  const __m128i v2=_mm_set1_epi8(c2);
+  const __m128i v3=_mm_set1_epi8(c3);
+
+  for ( ; end-buf>=16; buf+=16 ) {
+    __m128i d=_mm_loadu_si128((const __m128i *)buf);
+    __m128i m=_mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(d,v1),_mm_cmpeq_epi8(d,v2)),_mm_cmpeq_epi8(d,v3));
+    unsigned int mask=_mm_movemask_epi8(m);
+    if ( mask!=0 ) return buf+__builtin_ctz(mask);
+  }
+
+  return ScanScalar(buf,end,c1,c2,c3);
+}
+
+//*****************************************************************************
+__attribute__((target("avx2")))
+static const char *ScanAVX2(const char *buf, const char *end, char c1, char c2, char c3) {
+  const __m256i v1=_mm256_set1_epi8(c1);
+  const __m256i v2=_mm256_set1_epi8(c2);
+  const __m256i v3=_mm256_set1_epi8(c3);
+
+  for ( ; end-buf>=32; buf+=32 ) {
+    __m256i d=_mm256_loadu_si256((const __m256i *)buf);
+    __m256i m=_mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(d,v1),_mm256_cmpeq_epi8(d,v2)),_mm256_cmpeq_epi8(d,v3));
+    unsigned int mask=_mm256_movemask_epi8(m);
+    if ( mask!=0 ) return buf+__builtin_ctz(mask);
+  }
+
+  return ScanSSE2(buf,end,c1,c2,c3);
+}
+#endif
+
+//*****************************************************************************
+static tNMEA0183ScanFunc SelectScanFunc() {
+  #ifdef NMEA0183_SCAN_X86
+  __builtin_cpu_init();
+  if ( __builtin_cpu_supports("avx2") ) return ScanAVX2;
+  return ScanSSE2;
+  #else
+  return ScanScalar;
+  #endif
+}
+
+// Scanner is selected on first use, so that framing works also from static
+// constructors of other units, which may run before initializers of this unit.
+static inline tNMEA0183ScanFunc GetScanFunc() {
+  static const tNMEA0183ScanFunc ScanFunc=SelectScanFunc();
+  return ScanFunc;
+}
+
+//*****************************************************************************
+const char *NMEA0183FindMsgStart(const char *buf, const char *end) {
+  return GetScanFunc()(buf,end,'$','!','\\');
+}
+
+//*****************************************************************************
+const char *NMEA0183FindMsgDelimiter(const char *buf, const char *end) {
+  return GetScanFunc()(buf,end,'$','!','*');
+}
+
+//*****************************************************************************
+const char *NMEA0183ScanMethod() {
+  #ifdef NMEA0183_SCAN_X86
+  if ( GetScanFunc()==ScanAVX2 ) return "AVX2";
+  if ( GetScanFunc()==ScanSSE2 ) return "SSE2";
+  #endif
+  return "scalar";
+}
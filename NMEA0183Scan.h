@@ -0,0 +1,43 @@
+/*
+NMEA0183Scan.h
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+Delimiter scanning for message framing. On x86 platforms scanning uses SSE2 or
+AVX2 selected at runtime. Other platforms use simple byte loop.
+*/
+
+#ifndef _NMEA0183SCAN_H_
+#define _NMEA0183SCAN_H_
+
+#include <stddef.h>
+
+// Find first message or TAG block start character '$', '!' or '\' between buf and end.
+// Returns pointer to found character or end, if there is none.
+const char *NMEA0183FindMsgStart(const char *buf, const char *end);
+
+// Find first character, which changes framing state inside message: '$', '!' or '*'.
+// Returns pointer to found character or end, if there is none.
+const char *NMEA0183FindMsgDelimiter(const char *buf, const char *end);
+
+// Return name of scanner in use: "AVX2", "SSE2" or "scalar".
+const char *NMEA0183ScanMethod();
+
+#endif
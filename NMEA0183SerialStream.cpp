@@ -0,0 +1,137 @@
+/*
+NMEA0183SerialStream.cpp
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#if defined(__linux__)||defined(__linux)||defined(linux)
+
+#include <unistd.h>
+#include <string.h>
+#include <termios.h>
+#include <sys/ioctl.h>
+#include <linux/serial.h>
+#include "NMEA0183SerialStream.h"
+#include "NMEA0183RxTime.h"
+
+//*****************************************************************************
+static speed_t NMEA0183BaudToSpeed(uint32_t Baud) {
+  switch ( Baud ) {
+    case 1200: return B1200;
+    case 2400: return B2400;
+    case 4800: return B4800;
+    case 9600: return B9600;
+    case 19200: return B19200;
+    case 38400: return B38400;
+    case 57600: return B57600;
+    case 115200: return B115200;
+    case 230400: return B230400;
+    case 460800: return B460800;
+    case 921600: return B921600;
+    default: return B0;
+  }
+}
+
+//*****************************************************************************
+tNMEA0183SerialStream::tNMEA0183SerialStream(const char *Device, uint32_t Baud, bool LowLatency)
+: tNMEA0183LinuxStream(Device), RxPos(0), RxLen(0), RxBufTime(0), RxTime(0), ByteTime(0) {
+  Bridge=false;  // Failed port must not fall back to stdin and stdout
+  if ( port!=-1 && !Configure(Baud,LowLatency) ) {
+    close(port);
+    port=-1;
+  }
+}
+
+//*****************************************************************************
+bool tNMEA0183SerialStream::Configure(uint32_t Baud, bool LowLatency) {
+  speed_t Speed=NMEA0183BaudToSpeed(Baud);
+  struct termios tio;
+
+  if ( Speed==B0 || tcgetattr(port,&tio)!=0 ) return false;
+  ByteTime=10000000000ULL/Baud;
+
+  cfmakeraw(&tio);
+  tio.c_cflag&=~(CSTOPB | CRTSCTS);   // 8N1 without flow control
+  tio.c_cflag|=CLOCAL | CREAD;
+  // Port is non blocking, so read returns immediately. VMIN and VTIME are
+  // set for the case port is later changed to blocking.
+  tio.c_cc[VMIN]=1;
+  tio.c_cc[VTIME]=0;
+  if ( cfsetispeed(&tio,Speed)!=0 || cfsetospeed(&tio,Speed)!=0 ) return false;
+  if ( tcsetattr(port,TCSANOW,&tio)!=0 ) return false;
+  tcflush(port,TCIFLUSH);
+
+  if ( LowLatency ) { // Not all drivers support this, so failure is ignored.
+    struct serial_struct ss;
+    if ( ioctl(port,TIOCGSERIAL,&ss)==0 ) {
+      ss.flags|=ASYNC_LOW_LATENCY;
+      ioctl(port,TIOCSSERIAL,&ss);
+    }
+  }
+
+  return true;
+}
+
+//*****************************************************************************
+int tNMEA0183SerialStream::available() {
+  int n=0;
+
+  if ( port==-1 ) return 0;
+  if ( ioctl(port,FIONREAD,&n)!=0 ) n=0;
+
+  return RxLen-RxPos+n;
+}
+
+//*****************************************************************************
+int tNMEA0183SerialStream::read() {
+  if ( RxPos>=RxLen ) {
+    RxPos=RxLen=0;
+    RxLen=read(RxBuf,sizeof(RxBuf));
+    if ( RxLen==0 ) return -1;
+    RxBufTime=RxTime;
+  }
+
+  return RxBuf[RxPos++];
+}
+
+//*****************************************************************************
+size_t tNMEA0183SerialStream::read(uint8_t *buf, size_t max) {
+  if ( port==-1 ) return 0;
+
+  if ( RxPos<RxLen ) { // Data left from byte reads
+    size_t n=RxLen-RxPos;
+    if ( n>max ) n=max;
+    memcpy(buf,RxBuf+RxPos,n);
+    RxTime=RxBufTime+RxPos*ByteTime;
+    RxPos+=n;
+    return n;
+  }
+
+  ssize_t n=::read(port,buf,max);
+  if ( n<=0 ) return 0;
+
+  // Last byte arrived just before read returned and earlier ones one character time apart.
+  RxTime=NMEA0183RealTimeNs()-(uint64_t)(n-1)*ByteTime;
+
+  return n;
+}
+
+#endif
@@ -0,0 +1,66 @@
+/*
+NMEA0183SerialStream.h
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+Serial port stream for Linux. Port is opened non blocking and set to raw 8N1
+mode with given baud rate. Received data is read in blocks to internal buffer,
+so also reading byte by byte with read() does not make system call per byte.
+Read time is taken, when read(2) returns, and arrival of earlier bytes of block
+is interpolated with character time at baud rate. This assumes that port is
+read as soon as data arrives e.g. with ParseMessages(TimeoutMs) or poller and
+LowLatency, otherwise times are late by the time data waited in driver.
+*/
+
+#ifndef _NMEA0183_SERIAL_STREAM_H_
+#define _NMEA0183_SERIAL_STREAM_H_
+
+#include "NMEA0183LinuxStream.h"
+
+#if defined(__linux__)||defined(__linux)||defined(linux)
+
+#define MAX_NMEA0183_SERIAL_RX_BUF_LEN 256
+
+//-----------------------------------------------------------------------------
+class tNMEA0183SerialStream : public tNMEA0183LinuxStream {
+protected:
+  uint8_t RxBuf[MAX_NMEA0183_SERIAL_RX_BUF_LEN];
+  size_t RxPos;
+  size_t RxLen;
+  uint64_t RxBufTime;  // Arrival time of RxBuf[0]
+  uint64_t RxTime;     // Arrival time of first byte of last read
+  uint32_t ByteTime;   // Character time in ns (10 bits with 8N1)
+
+  bool Configure(uint32_t Baud, bool LowLatency);
+
+public:
+  // Open Device with Baud (e.g. 4800 or 38400). With LowLatency driver is asked to
+  // deliver received data immediately (ASYNC_LOW_LATENCY), if it supports that.
+  // Use IsOpen to check was port opened and configured.
+  tNMEA0183SerialStream(const char *Device, uint32_t Baud=4800, bool LowLatency=false);
+  // Count of bytes waiting on internal buffer and driver.
+  int available();
+  int read();
+  size_t read(uint8_t *buf, size_t max);
+  uint64_t GetReadTime(uint32_t &_ByteTime) { _ByteTime=ByteTime; return RxTime; }
+};
+#endif
+
+#endif /* _NMEA0183_SERIAL_STREAM_H_ */
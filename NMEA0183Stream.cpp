@@ -30,6 +30,19 @@ I/O stream used in the NMEA0183 library.
 #ifdef ARDUINO
 // Arduino uses its own implementation.
 #else
+size_t tNMEA0183Stream::read(uint8_t *buf, size_t max) {
+   size_t n=0;
+
+   for ( ; n<max && available()>0; n++) {
+      int c=read();
+      if(c < 0)
+         break;
+      buf[n]=c;
+   }
+
+   return n;
+}
+
 size_t tNMEA0183Stream::print(const char *str) {
    if(str == 0)
       return 0;
@@ -45,6 +45,26 @@ class tNMEA0183Stream {
    virtual int availableForWrite() { return 1; }
    // Returns first byte if incoming data, or -1 on no available data.
    virtual int read() = 0;
+   // Read available data to buf up to max bytes. Returns count of bytes read or
+   // 0 on no available data. Default implementation reads byte by byte with read(),
+   // so streams able to read blocks should override this.
+   virtual size_t read(uint8_t *buf, size_t max);
+   // Descriptors for waiting stream with poll(2). Return -1, if stream does not
+   // have descriptor.
+   virtual int GetReadFd() const { return -1; }
+   virtual int GetWriteFd() const { return -1; }
+   // What to wait, when stream has temporarily no read descriptor e.g. while connecting
+   // or waiting to reconnect. Set fd and poll(2) Events to wait or fd to -1 for plain
+   // sleep and MaxWaitMs to time, when stream should be called again. Return false, if
+   // stream can not be waited.
+   virtual bool GetPendingWait(int &fd, short &Events, uint32_t &MaxWaitMs) { (void)fd; (void)Events; (void)MaxWaitMs; return false; }
+   // Returns true once after stream has lost data e.g. on reconnect, so that
+   // reader drops partially received message.
+   virtual bool Restarted() { return false; }
+   // Arrival time of first byte returned by last read(buf,max) in ns since 1.1.1970
+   // (CLOCK_REALTIME) or 0, if stream does not know it. ByteTime is set to interval of
+   // following bytes, which is 0 for data arrived at once like socket data.
+   virtual uint64_t GetReadTime(uint32_t &ByteTime) { ByteTime=0; return 0; }
 
    // Write data to stream.
    virtual size_t write(const uint8_t* data, size_t size) = 0;
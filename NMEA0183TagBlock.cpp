@@ -0,0 +1,114 @@
+/*
+NMEA0183TagBlock.cpp
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#include <string.h>
+#include "NMEA0183TagBlock.h"
+#include "NMEA0183Msg.h"
+
+//*****************************************************************************
+// Parse unsigned number and move buf after it. Returns count of digits.
+static uint8_t ParseUInt(const char *&buf, const char *end, uint64_t &val) {
+  uint8_t digits=0;
+
+  for ( val=0; buf<end && *buf>='0' && *buf<='9'; buf++, digits++ ) {
+    val=val*10+(*buf-'0');
+  }
+
+  return digits;
+}
+
+//*****************************************************************************
+void tNMEA0183TagBlock::Parse(const char *buf, size_t len) {
+  const char *end=buf+len;
+
+  Clear();
+  while ( buf<end ) {
+    const char *ParamEnd=(const char *)memchr(buf,',',end-buf);
+    if ( ParamEnd==0 ) ParamEnd=end;
+
+    if ( ParamEnd-buf>=2 && buf[1]==':' ) {
+      char Code=buf[0];
+      const char *p=buf+2;
+      uint64_t val;
+
+      switch ( Code ) {
+        case 's': {
+            size_t n=ParamEnd-p;
+            if ( n>MAX_NMEA0183_TAG_SOURCE_LEN ) n=MAX_NMEA0183_TAG_SOURCE_LEN;
+            memcpy(Source,p,n);
+            Source[n]=0;
+            Flags|=tbSource;
+          }
+          break;
+        case 'c': {
+            uint8_t digits=ParseUInt(p,ParamEnd,val);
+            if ( digits==0 ) break;
+            if ( digits>10 ) { // Time in milliseconds
+              UnixTime=val/1000;
+              UnixTimeMs=val%1000;
+            } else {
+              UnixTime=val;
+              UnixTimeMs=0;
+            }
+            Flags|=tbUnixTime;
+          }
+          break;
+        case 'n':
+          if ( ParseUInt(p,ParamEnd,val)>0 ) {
+            LineCount=val;
+            Flags|=tbLineCount;
+          }
+          break;
+        case 'g': { // sentence-total-id
+            uint64_t Sentence, Sentences;
+            if ( ParseUInt(p,ParamEnd,Sentence)==0 || p>=ParamEnd || *p++!='-' ) break;
+            if ( ParseUInt(p,ParamEnd,Sentences)==0 || p>=ParamEnd || *p++!='-' ) break;
+            if ( ParseUInt(p,ParamEnd,val)==0 ) break;
+            GroupSentence=Sentence;
+            GroupSentences=Sentences;
+            GroupId=val;
+            Flags|=tbGroup;
+          }
+          break;
+      }
+    }
+
+    buf=ParamEnd+1;
+  }
+}
+
+//*****************************************************************************
+bool tNMEA0183TagBlock::SetTagBlock(const char *buf, size_t len) {
+  Clear();
+
+  const char *DataEnd=(const char *)memchr(buf,'*',len);
+  if ( DataEnd==0 || DataEnd+3!=buf+len ) return false;
+
+  uint8_t cs=0;
+  for ( const char *p=buf; p<DataEnd; p++ ) cs^=*p;
+  if ( cs!=((tNMEA0183MsgBase::HexToNibble(DataEnd[1])<<4) | tNMEA0183MsgBase::HexToNibble(DataEnd[2])) ) return false;
+
+  Parse(buf,DataEnd-buf);
+  return true;
+}
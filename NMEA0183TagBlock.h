@@ -0,0 +1,68 @@
+/*
+NMEA0183TagBlock.h
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+NMEA 4.x TAG block parsing. TAG block precedes sentence like
+\s:station,c:1700000000*hh\!AIVDM,...
+Checksum is calculated over characters between leading '\' and '*'.
+*/
+
+#ifndef _NMEA0183TAGBLOCK_H_
+#define _NMEA0183TAGBLOCK_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define MAX_NMEA0183_TAG_LEN 80  // Max length of TAG block content between '\' and '*'
+#define MAX_NMEA0183_TAG_SOURCE_LEN 15
+
+//------------------------------------------------------------------------------
+struct tNMEA0183TagBlock
+{
+  // Flags for parameters found on TAG block
+  enum {
+        tbSource=1,     // s:
+        tbUnixTime=2,   // c:
+        tbLineCount=4,  // n:
+        tbGroup=8       // g:
+      };
+
+  uint8_t Flags;             // Parameters found. 0 if there was no TAG block.
+  char Source[MAX_NMEA0183_TAG_SOURCE_LEN+1]; // Source identifier. Truncated, if longer.
+  uint32_t UnixTime;         // Seconds since 1.1.1970
+  uint16_t UnixTimeMs;       // Milliseconds, if time was given in milliseconds
+  uint32_t LineCount;
+  uint8_t GroupSentence;     // Sentence number on group
+  uint8_t GroupSentences;    // Total sentences on group
+  uint32_t GroupId;
+
+  tNMEA0183TagBlock() { Clear(); }
+  void Clear() { Flags=0; }
+  bool Has(uint8_t Flag) const { return (Flags & Flag)!=0; }
+  // Parse TAG block content without checksum, e.g. "s:station,c:1700000000".
+  // Unknown parameters will be ignored.
+  void Parse(const char *buf, size_t len);
+  // Set from complete TAG block between '\' characters including checksum, e.g.
+  // "s:station,c:1700000000*hh". Returns false, if checksum is invalid.
+  bool SetTagBlock(const char *buf, size_t len);
+};
+
+#endif
@@ -0,0 +1,233 @@
+/*
+NMEA0183TcpClientStream.cpp
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#if defined(__linux__)||defined(__linux)||defined(linux)
+
+#include <errno.h>
+#include <string.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+#include <netdb.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include "NMEA0183TcpClientStream.h"
+#include "NMEA0183RxTime.h"
+
+//*****************************************************************************
+static uint64_t NMEA0183TcpMonotonicMs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC,&ts);
+  return (uint64_t)ts.tv_sec*1000+ts.tv_nsec/1000000;
+}
+
+//*****************************************************************************
+tNMEA0183TcpClientStream::tNMEA0183TcpClientStream(const char *_Host, uint16_t _Port, uint32_t _MinBackoffMs, uint32_t _MaxBackoffMs,
+                                                   size_t _RxBufSize)
+: Host(0), Port(_Port), fd(-1), State(csDisconnected), MinBackoffMs(_MinBackoffMs), MaxBackoffMs(_MaxBackoffMs),
+  BackoffMs(_MinBackoffMs), NextConnect(0), DataLost(false), Connects(0), RxBufSize(_RxBufSize), RxPos(0), RxLen(0), RxTime(0) {
+  if ( _Host!=0 ) {
+    Host=new char[strlen(_Host)+1];
+    strcpy(Host,_Host);
+  }
+  if ( MaxBackoffMs<MinBackoffMs ) MaxBackoffMs=MinBackoffMs;
+  if ( RxBufSize==0 ) RxBufSize=1;
+  RxBuf=new char[RxBufSize];
+  StartConnect();
+}
+
+//*****************************************************************************
+tNMEA0183TcpClientStream::~tNMEA0183TcpClientStream() {
+  if ( fd!=-1 ) close(fd);
+  delete[] Host;
+  delete[] RxBuf;
+}
+
+//*****************************************************************************
+void tNMEA0183TcpClientStream::StartConnect() {
+  if ( Host==0 ) return;
+
+  struct addrinfo Hints, *Res=0;
+  char PortStr[6];
+
+  memset(&Hints,0,sizeof(Hints));
+  Hints.ai_family=AF_UNSPEC;
+  Hints.ai_socktype=SOCK_STREAM;
+  snprintf(PortStr,sizeof(PortStr),"%u",Port);
+  // Note that resolving name may block. Use address to avoid that.
+  if ( getaddrinfo(Host,PortStr,&Hints,&Res)==0 ) {
+    fd=socket(Res->ai_family,Res->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC,Res->ai_protocol);
+    if ( fd!=-1 ) {
+      if ( connect(fd,Res->ai_addr,Res->ai_addrlen)==0 ) {
+        State=csConnected;
+      } else if ( errno==EINPROGRESS ) {
+        State=csConnecting;
+      } else {
+        close(fd);
+        fd=-1;
+      }
+    }
+    freeaddrinfo(Res);
+  }
+
+  if ( State!=csDisconnected ) NMEA0183EnableRxTime(fd);
+  if ( State==csConnected ) {
+    int On=1;
+    setsockopt(fd,IPPROTO_TCP,TCP_NODELAY,&On,sizeof(On));
+    BackoffMs=MinBackoffMs;
+    Connects++;
+  } else if ( State==csDisconnected ) {
+    NextConnect=NMEA0183TcpMonotonicMs()+BackoffMs;
+    BackoffMs=( BackoffMs>MaxBackoffMs/2?MaxBackoffMs:2*BackoffMs );
+  }
+}
+
+//*****************************************************************************
+void tNMEA0183TcpClientStream::Disconnect() {
+  if ( fd!=-1 ) close(fd);
+  fd=-1;
+  if ( State==csConnected ) { // Data of lost connection is not valid any more
+    DataLost=true;
+    RxPos=RxLen=0;
+  }
+  State=csDisconnected;
+  NextConnect=NMEA0183TcpMonotonicMs()+BackoffMs;
+  BackoffMs=( BackoffMs>MaxBackoffMs/2?MaxBackoffMs:2*BackoffMs );
+}
+
+//*****************************************************************************
+void tNMEA0183TcpClientStream::Service() {
+  switch ( State ) {
+    case csDisconnected:
+      if ( NMEA0183TcpMonotonicMs()>=NextConnect ) StartConnect();
+      break;
+    case csConnecting: {
+        struct pollfd pfd={fd,POLLOUT,0};
+        if ( poll(&pfd,1,0)<=0 ) break;  // Still connecting
+        int Error=0;
+        socklen_t len=sizeof(Error);
+        if ( getsockopt(fd,SOL_SOCKET,SO_ERROR,&Error,&len)!=0 || Error!=0 ) {
+          Disconnect();
+        } else {
+          int On=1;
+          setsockopt(fd,IPPROTO_TCP,TCP_NODELAY,&On,sizeof(On));
+          State=csConnected;
+          BackoffMs=MinBackoffMs;
+          Connects++;
+        }
+      }
+      break;
+  }
+}
+
+//*****************************************************************************
+bool tNMEA0183TcpClientStream::IsConnected() {
+  Service();
+  return State==csConnected;
+}
+
+//*****************************************************************************
+bool tNMEA0183TcpClientStream::GetPendingWait(int &_fd, short &Events, uint32_t &MaxWaitMs) {
+  Service();
+  switch ( State ) {
+    case csConnecting:
+      _fd=fd;
+      Events=POLLOUT;
+      MaxWaitMs=UINT32_MAX;
+      return true;
+    case csDisconnected: {
+        uint64_t Now=NMEA0183TcpMonotonicMs();
+        _fd=-1;
+        Events=0;
+        if ( Host==0 ) {
+          MaxWaitMs=UINT32_MAX;  // Never connects
+        } else {
+          MaxWaitMs=( NextConnect>Now?(uint32_t)(NextConnect-Now):0 );
+        }
+      }
+      return true;
+  }
+  return false;
+}
+
+//*****************************************************************************
+bool tNMEA0183TcpClientStream::Restarted() {
+  bool result=DataLost;
+  DataLost=false;
+  return result;
+}
+
+//*****************************************************************************
+int tNMEA0183TcpClientStream::available() {
+  Service();
+  return RxLen-RxPos+( State==csConnected?1:0 );
+}
+
+//*****************************************************************************
+int tNMEA0183TcpClientStream::read() {
+  uint8_t c;
+  return ( read(&c,1)==1?c:-1 );
+}
+
+//*****************************************************************************
+size_t tNMEA0183TcpClientStream::read(uint8_t *buf, size_t max) {
+  if ( RxPos>=RxLen ) {
+    Service();
+    if ( State!=csConnected ) return 0;
+
+    ssize_t n=NMEA0183RecvTimed(fd,RxBuf,RxBufSize,MSG_DONTWAIT,RxTime);
+    if ( n==0 || (n<0 && errno!=EAGAIN && errno!=EWOULDBLOCK && errno!=EINTR) ) { // Closed by server or failed
+      Disconnect();
+      return 0;
+    }
+    if ( n<0 ) return 0;
+    RxPos=0;
+    RxLen=n;
+  }
+
+  size_t n=RxLen-RxPos;
+  if ( n>max ) n=max;
+  memcpy(buf,RxBuf+RxPos,n);
+  RxPos+=n;
+
+  return n;
+}
+
+//*****************************************************************************
+size_t tNMEA0183TcpClientStream::write(const uint8_t* data, size_t size) {
+  Service();
+  if ( State!=csConnected ) return 0;
+
+  ssize_t n=send(fd,data,size,MSG_DONTWAIT | MSG_NOSIGNAL);
+  if ( n<0 && errno!=EAGAIN && errno!=EWOULDBLOCK && errno!=EINTR ) {
+    Disconnect();
+    return 0;
+  }
+
+  return ( n>0?n:0 );
+}
+
+#endif
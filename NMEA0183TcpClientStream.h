@@ -0,0 +1,96 @@
+/*
+NMEA0183TcpClientStream.h
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+TCP client stream for Linux. Stream connects non blocking to NMEA0183 server
+like chartplotter gateway or AIS server and reconnects with exponential
+backoff, when connection fails or is closed. Connection is handled on stream
+calls, so it does not need own thread. Received data is read to large buffer
+and given to reader in chunks. After reconnect, Restarted tells tNMEA0183 to
+drop partially received message.
+*/
+
+#ifndef _NMEA0183_TCP_CLIENT_STREAM_H_
+#define _NMEA0183_TCP_CLIENT_STREAM_H_
+
+#include "NMEA0183Stream.h"
+
+#if defined(__linux__)||defined(__linux)||defined(linux)
+
+#define DEF_NMEA0183_TCP_RX_BUF_LEN 16384
+
+//-----------------------------------------------------------------------------
+class tNMEA0183TcpClientStream : public tNMEA0183Stream {
+protected:
+  enum tState { csDisconnected, csConnecting, csConnected };
+  char *Host;
+  uint16_t Port;
+  int fd;
+  uint8_t State;
+  uint32_t MinBackoffMs;
+  uint32_t MaxBackoffMs;
+  uint32_t BackoffMs;      // Wait before next connect attempt
+  uint64_t NextConnect;    // Monotonic ms of next connect attempt
+  bool DataLost;
+  uint32_t Connects;
+  char *RxBuf;
+  size_t RxBufSize;
+  size_t RxPos;
+  size_t RxLen;
+  uint64_t RxTime;         // Kernel receive time of data in RxBuf
+
+  void StartConnect();
+  void Disconnect();
+  // Start or complete connection, when needed.
+  void Service();
+
+public:
+  // Connect to Host (name or address) and Port. Failed connection is retried after
+  // MinBackoffMs and wait doubles on each failure up to MaxBackoffMs.
+  tNMEA0183TcpClientStream(const char *_Host, uint16_t _Port, uint32_t _MinBackoffMs=500, uint32_t _MaxBackoffMs=30000,
+                           size_t _RxBufSize=DEF_NMEA0183_TCP_RX_BUF_LEN);
+  virtual ~tNMEA0183TcpClientStream();
+  tNMEA0183TcpClientStream(const tNMEA0183TcpClientStream &)=delete;
+  tNMEA0183TcpClientStream &operator=(const tNMEA0183TcpClientStream &)=delete;
+
+  bool IsConnected();
+  // Count of established connections.
+  uint32_t GetConnects() const { return Connects; }
+  int available();
+  int read();
+  size_t read(uint8_t *buf, size_t max);
+  // Data is written only, when connected. Otherwise nothing is accepted and tNMEA0183
+  // keeps messages buffered.
+  size_t write(const uint8_t* data, size_t size);
+  // Socket descriptor. Note that it changes on reconnect and it is -1, when not connected.
+  // tNMEA0183Poller registers descriptor on Add, so with poller remove and add port
+  // again, when GetConnects changes.
+  int GetReadFd() const { return ( State==csConnected?fd:-1 ); }
+  int GetWriteFd() const { return ( State==csConnected?fd:-1 ); }
+  // While connecting socket is waited for POLLOUT and during backoff until next connect.
+  bool GetPendingWait(int &_fd, short &Events, uint32_t &MaxWaitMs);
+  bool Restarted();
+  // Kernel receive timestamp of last read data.
+  uint64_t GetReadTime(uint32_t &ByteTime) { ByteTime=0; return RxTime; }
+};
+#endif
+
+#endif /* _NMEA0183_TCP_CLIENT_STREAM_H_ */
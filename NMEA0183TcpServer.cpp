@@ -0,0 +1,269 @@
+/*
+NMEA0183TcpServer.cpp
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#if defined(__linux__)||defined(__linux)||defined(linux)
+
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include "NMEA0183TcpServer.h"
+#include "NMEA0183RxTime.h"
+
+#define NMEA0183_TCP_SERVER_EVENTS 64
+
+// Connection under Feed. Message handler of tNMEA0183 does not have context, so
+// connection is given to it with this.
+static thread_local void *NMEA0183TcpServerConnection=0;
+static thread_local const tNMEA0183TcpServer::tMsgHandler *NMEA0183TcpServerHandler=0;
+
+//*****************************************************************************
+static uint64_t NMEA0183TcpServerNs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC,&ts);
+  return (uint64_t)ts.tv_sec*1000000000ULL+ts.tv_nsec;
+}
+
+//*****************************************************************************
+tNMEA0183TcpServer::tNMEA0183TcpServer(tMsgHandler _MsgHandler, size_t _WorkerCount, size_t _MaxConnections)
+: MsgHandler(_MsgHandler), WorkerCount(_WorkerCount), MaxConnections(_MaxConnections),
+  NextConnectionID(1), ConnectionCount(0), Port(0) {
+  if ( WorkerCount==0 ) WorkerCount=std::thread::hardware_concurrency();
+  if ( WorkerCount==0 ) WorkerCount=1;
+}
+
+//*****************************************************************************
+tNMEA0183TcpServer::~tNMEA0183TcpServer() {
+  Close();
+}
+
+//*****************************************************************************
+bool tNMEA0183TcpServer::Open(uint16_t _Port, const char *LocalAddress) {
+  Close();
+
+  struct sockaddr_in Addr;
+  memset(&Addr,0,sizeof(Addr));
+  Addr.sin_family=AF_INET;
+  Addr.sin_port=htons(_Port);
+  Addr.sin_addr.s_addr=htonl(INADDR_ANY);
+  if ( LocalAddress!=0 && inet_pton(AF_INET,LocalAddress,&Addr.sin_addr)!=1 ) return false;
+
+  // Each worker has own listening socket on same port.
+  for ( size_t i=0; i<WorkerCount; i++ ) {
+    tWorker *Worker=new tWorker();
+    Worker->EpollFd=epoll_create1(EPOLL_CLOEXEC);
+    Worker->WakeFd=eventfd(0,EFD_NONBLOCK | EFD_CLOEXEC);
+    Worker->ListenFd=socket(AF_INET,SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC,0);
+    Workers.push_back(Worker);
+
+    int On=1;
+    setsockopt(Worker->ListenFd,SOL_SOCKET,SO_REUSEADDR,&On,sizeof(On));
+    setsockopt(Worker->ListenFd,SOL_SOCKET,SO_REUSEPORT,&On,sizeof(On));
+    if ( Worker->EpollFd==-1 || Worker->WakeFd==-1 || Worker->ListenFd==-1 ||
+         bind(Worker->ListenFd,(struct sockaddr *)&Addr,sizeof(Addr))!=0 ||
+         listen(Worker->ListenFd,SOMAXCONN)!=0 ) {
+      Close();
+      return false;
+    }
+    if ( i==0 ) { // Rest of workers bind to port selected for first.
+      socklen_t len=sizeof(Addr);
+      getsockname(Worker->ListenFd,(struct sockaddr *)&Addr,&len);
+      Port=ntohs(Addr.sin_port);
+    }
+
+    struct epoll_event ev;
+    ev.events=EPOLLIN;
+    ev.data.ptr=0;  // Listening socket
+    epoll_ctl(Worker->EpollFd,EPOLL_CTL_ADD,Worker->ListenFd,&ev);
+    ev.data.ptr=Worker;
+    epoll_ctl(Worker->EpollFd,EPOLL_CTL_ADD,Worker->WakeFd,&ev);
+  }
+
+  for ( size_t i=0; i<Workers.size(); i++ ) {
+    Workers[i]->Thread=std::thread(&tNMEA0183TcpServer::Run,this,Workers[i]);
+  }
+
+  return true;
+}
+
+//*****************************************************************************
+void tNMEA0183TcpServer::Close() {
+  for ( size_t i=0; i<Workers.size(); i++ ) {
+    uint64_t One=1;
+    if ( Workers[i]->WakeFd!=-1 && write(Workers[i]->WakeFd,&One,sizeof(One))!=sizeof(One) ) {}
+  }
+  for ( size_t i=0; i<Workers.size(); i++ ) {
+    tWorker *Worker=Workers[i];
+    if ( Worker->Thread.joinable() ) Worker->Thread.join();  // Worker closes its connections
+    if ( Worker->ListenFd!=-1 ) close(Worker->ListenFd);
+    if ( Worker->WakeFd!=-1 ) close(Worker->WakeFd);
+    if ( Worker->EpollFd!=-1 ) close(Worker->EpollFd);
+    delete Worker;
+  }
+  Workers.clear();
+  Port=0;
+}
+
+//*****************************************************************************
+void tNMEA0183TcpServer::Run(tWorker *Worker) {
+  struct epoll_event Events[NMEA0183_TCP_SERVER_EVENTS];
+  char *Buf=new char[NMEA0183_TCP_SERVER_READ_BUF_LEN];
+
+  NMEA0183TcpServerHandler=&MsgHandler;
+  for ( bool Stop=false; !Stop; ) {
+    int n=epoll_wait(Worker->EpollFd,Events,NMEA0183_TCP_SERVER_EVENTS,-1);
+    if ( n<0 && errno!=EINTR ) break;
+    for ( int i=0; i<n && !Stop; i++ ) {
+      if ( Events[i].data.ptr==Worker ) { // Stop request
+        Stop=true;
+      } else if ( Events[i].data.ptr==0 ) {
+        Accept(Worker);
+      } else {
+        Read(Worker,(tConnection *)Events[i].data.ptr,Buf);
+      }
+    }
+  }
+  // Close connections here, so that connection handler is called on worker thread.
+  while ( !Worker->Connections.empty() ) CloseConnection(Worker,Worker->Connections.back());
+  delete[] Buf;
+}
+
+//*****************************************************************************
+void tNMEA0183TcpServer::Accept(tWorker *Worker) {
+  for (;;) {
+    struct sockaddr_in Peer;
+    socklen_t len=sizeof(Peer);
+    int fd=accept4(Worker->ListenFd,(struct sockaddr *)&Peer,&len,SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if ( fd==-1 ) return;  // EAGAIN or error. Other worker may have taken connection.
+
+    // Reserve place first, since other workers accept at same time.
+    if ( ConnectionCount.fetch_add(1)>=MaxConnections ) {
+      ConnectionCount--;
+      close(fd);
+      continue;
+    }
+
+    NMEA0183EnableRxTime(fd);
+    tConnection *Connection=new tConnection();
+    Connection->fd=fd;
+    Connection->ConnectionID=NextConnectionID++;
+    Connection->Peer=Peer;
+    Connection->ConnectedAt=NMEA0183TcpServerNs();
+    Connection->Bytes=0;
+    Connection->Messages=0;
+    Connection->Errors=0;
+    Connection->NMEA0183.SetMsgHandler(HandleMessage);
+
+    struct epoll_event ev;
+    ev.events=EPOLLIN | EPOLLRDHUP | EPOLLET;
+    ev.data.ptr=Connection;
+    if ( epoll_ctl(Worker->EpollFd,EPOLL_CTL_ADD,fd,&ev)!=0 ) {
+      ConnectionCount--;
+      close(fd);
+      delete Connection;
+      continue;
+    }
+    {
+      std::lock_guard<std::mutex> lk(Worker->Lock);
+      Worker->Connections.push_back(Connection);
+    }
+    if ( ConnectionHandler ) ConnectionHandler(Connection->ConnectionID,Connection->Peer,true);
+  }
+}
+
+//*****************************************************************************
+void tNMEA0183TcpServer::HandleMessage(const tNMEA0183Msg &Msg) {
+  tConnection *Connection=(tConnection *)NMEA0183TcpServerConnection;
+  Connection->Messages.store(Connection->Messages.load(std::memory_order_relaxed)+1,std::memory_order_relaxed);
+  if ( *NMEA0183TcpServerHandler ) (*NMEA0183TcpServerHandler)(Msg,Connection->ConnectionID);
+}
+
+//*****************************************************************************
+void tNMEA0183TcpServer::Read(tWorker *Worker, tConnection *Connection, char *Buf) {
+  NMEA0183TcpServerConnection=Connection;
+  // Edge triggered, so read until there is no more data.
+  for (;;) {
+    uint64_t RxTime;
+    ssize_t n=NMEA0183RecvTimed(Connection->fd,Buf,NMEA0183_TCP_SERVER_READ_BUF_LEN,0,RxTime);
+    if ( n>0 ) {
+      Connection->Bytes.store(Connection->Bytes.load(std::memory_order_relaxed)+n,std::memory_order_relaxed);
+      Connection->NMEA0183.SetFeedTime(RxTime);
+      Connection->NMEA0183.Feed(Buf,n);
+      continue;
+    }
+    if ( n<0 && (errno==EAGAIN || errno==EWOULDBLOCK) ) break;
+    if ( n<0 && errno==EINTR ) continue;
+    CloseConnection(Worker,Connection);  // Closed by client or failed
+    return;
+  }
+  Connection->Errors.store(Connection->NMEA0183.GetStats().Errors,std::memory_order_relaxed);
+}
+
+//*****************************************************************************
+void tNMEA0183TcpServer::CloseConnection(tWorker *Worker, tConnection *Connection) {
+  {
+    std::lock_guard<std::mutex> lk(Worker->Lock);
+    for ( size_t i=0; i<Worker->Connections.size(); i++ ) {
+      if ( Worker->Connections[i]==Connection ) {
+        Worker->Connections[i]=Worker->Connections.back();
+        Worker->Connections.pop_back();
+        break;
+      }
+    }
+  }
+  epoll_ctl(Worker->EpollFd,EPOLL_CTL_DEL,Connection->fd,0);
+  close(Connection->fd);
+  ConnectionCount--;
+  if ( ConnectionHandler ) ConnectionHandler(Connection->ConnectionID,Connection->Peer,false);
+  delete Connection;
+}
+
+//*****************************************************************************
+void tNMEA0183TcpServer::GetConnectionStats(std::vector<tNMEA0183ConnectionStats> &Stats) {
+  uint64_t Now=NMEA0183TcpServerNs();
+
+  Stats.clear();
+  for ( size_t w=0; w<Workers.size(); w++ ) {
+    std::lock_guard<std::mutex> lk(Workers[w]->Lock);
+    for ( size_t i=0; i<Workers[w]->Connections.size(); i++ ) {
+      const tConnection *Connection=Workers[w]->Connections[i];
+      tNMEA0183ConnectionStats s;
+      s.ConnectionID=Connection->ConnectionID;
+      s.Peer=Connection->Peer;
+      s.Bytes=Connection->Bytes.load(std::memory_order_relaxed);
+      s.Messages=Connection->Messages.load(std::memory_order_relaxed);
+      s.Errors=Connection->Errors.load(std::memory_order_relaxed);
+      s.ConnectedSecs=(Now-Connection->ConnectedAt)/1e9;
+      s.MessagesPerSec=( s.ConnectedSecs>0?s.Messages/s.ConnectedSecs:0 );
+      s.BytesPerSec=( s.ConnectedSecs>0?s.Bytes/s.ConnectedSecs:0 );
+      Stats.push_back(s);
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,129 @@
+/*
+NMEA0183TcpServer.h
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+TCP server for receiving NMEA0183 from many clients. Connections are shared
+to worker threads, each with own listening socket (SO_REUSEPORT) and epoll
+loop, so kernel balances new connections between workers and connection is
+handled always by same thread. Each connection has own message framing and
+messages get kernel receive time of data as RxTime.
+Messages are given to handler with connection id on worker thread, so
+handler must be thread safe.
+
+Only for Linux.
+*/
+
+#ifndef _NMEA0183TCPSERVER_H_
+#define _NMEA0183TCPSERVER_H_
+
+#if defined(__linux__)||defined(__linux)||defined(linux)
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <netinet/in.h>
+#include "NMEA0183.h"
+
+#define NMEA0183_TCP_SERVER_READ_BUF_LEN 65536
+
+//------------------------------------------------------------------------------
+struct tNMEA0183ConnectionStats {
+  uint32_t ConnectionID;
+  struct sockaddr_in Peer;
+  uint64_t Bytes;
+  uint64_t Messages;
+  uint64_t Errors;            // Invalid messages
+  double ConnectedSecs;       // Time since connection was accepted
+  double MessagesPerSec;      // Average over connection time
+  double BytesPerSec;
+};
+
+//------------------------------------------------------------------------------
+class tNMEA0183TcpServer
+{
+  public:
+    // Handler for received message. Called on worker thread of connection.
+    typedef std::function<void(const tNMEA0183Msg &Msg, uint32_t ConnectionID)> tMsgHandler;
+    // Handler for connection open (Connected true) and close. Called on worker thread.
+    typedef std::function<void(uint32_t ConnectionID, const struct sockaddr_in &Peer, bool Connected)> tConnectionHandler;
+
+  protected:
+    struct tConnection {
+      int fd;
+      uint32_t ConnectionID;
+      struct sockaddr_in Peer;
+      uint64_t ConnectedAt;  // Monotonic ns
+      std::atomic<uint64_t> Bytes;
+      std::atomic<uint64_t> Messages;
+      std::atomic<uint64_t> Errors;
+      tNMEA0183 NMEA0183;    // Framing for connection
+    };
+    struct tWorker {
+      int EpollFd;
+      int ListenFd;
+      int WakeFd;            // eventfd for stopping
+      std::thread Thread;
+      std::mutex Lock;       // Protects Connections for statistics
+      std::vector<tConnection *> Connections;
+    };
+
+    tMsgHandler MsgHandler;
+    tConnectionHandler ConnectionHandler;
+    std::vector<tWorker *> Workers;
+    size_t WorkerCount;
+    size_t MaxConnections;
+    std::atomic<uint32_t> NextConnectionID;
+    std::atomic<size_t> ConnectionCount;
+    uint16_t Port;
+
+    void Run(tWorker *Worker);
+    void Accept(tWorker *Worker);
+    void Read(tWorker *Worker, tConnection *Connection, char *Buf);
+    void CloseConnection(tWorker *Worker, tConnection *Connection);
+    static void HandleMessage(const tNMEA0183Msg &Msg);
+
+  public:
+    // Create server with WorkerCount threads (0 uses hardware concurrency). New
+    // connections will be refused, when there are MaxConnections connections.
+    tNMEA0183TcpServer(tMsgHandler _MsgHandler, size_t WorkerCount=0, size_t _MaxConnections=10000);
+    ~tNMEA0183TcpServer();
+    tNMEA0183TcpServer(const tNMEA0183TcpServer &)=delete;
+    tNMEA0183TcpServer &operator=(const tNMEA0183TcpServer &)=delete;
+
+    // Set before Open.
+    void SetConnectionHandler(tConnectionHandler _ConnectionHandler) { ConnectionHandler=_ConnectionHandler; }
+    // Start listening Port (0 selects free port) and start workers.
+    bool Open(uint16_t _Port, const char *LocalAddress=0);
+    // Stop workers and close all connections. Connection handler is called for closed
+    // connections on their worker threads before Close returns.
+    void Close();
+    bool IsOpen() const { return !Workers.empty() && Workers[0]->Thread.joinable(); }
+    uint16_t GetPort() const { return Port; }
+    size_t GetConnectionCount() const { return ConnectionCount; }
+    size_t GetWorkerCount() const { return Workers.size(); }
+    // Get statistics of open connections.
+    void GetConnectionStats(std::vector<tNMEA0183ConnectionStats> &Stats);
+};
+
+#endif
+
+#endif
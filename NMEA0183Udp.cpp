@@ -0,0 +1,184 @@
+/*
+NMEA0183Udp.cpp
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#if defined(__linux__)||defined(__linux)||defined(linux)
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include "NMEA0183Udp.h"
+#include "NMEA0183RxTime.h"
+
+//*****************************************************************************
+tNMEA0183UdpReceiver::tNMEA0183UdpReceiver(tNMEA0183::tMsgHandler _MsgHandler, uint8_t _FirstSourceID)
+: fd(-1), MsgHandler(_MsgHandler), FirstSourceID(_FirstSourceID), SenderCount(0), Dropped(0), Truncated(0), Buffers(0) {
+}
+
+//*****************************************************************************
+tNMEA0183UdpReceiver::~tNMEA0183UdpReceiver() {
+  Close();
+  for ( uint8_t i=0; i<SenderCount; i++ ) delete Senders[i].NMEA0183;
+  delete[] Buffers;
+}
+
+//*****************************************************************************
+bool tNMEA0183UdpReceiver::Open(uint16_t Port, const char *MulticastGroup, const char *LocalAddress) {
+  Close();
+
+  struct sockaddr_in Addr;
+  struct in_addr Local;
+  memset(&Addr,0,sizeof(Addr));
+  Addr.sin_family=AF_INET;
+  Addr.sin_port=htons(Port);
+  Local.s_addr=htonl(INADDR_ANY);
+  if ( LocalAddress!=0 && inet_pton(AF_INET,LocalAddress,&Local)!=1 ) return false;
+  // Multicast socket is bound to group address, so that it does not get other traffic to port.
+  if ( MulticastGroup!=0 ) {
+    if ( inet_pton(AF_INET,MulticastGroup,&Addr.sin_addr)!=1 ) return false;
+  } else {
+    Addr.sin_addr=Local;
+  }
+
+  fd=socket(AF_INET,SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC,0);
+  if ( fd==-1 ) return false;
+
+  int On=1;
+  // Several programs on same host may listen multiplexer broadcasts.
+  setsockopt(fd,SOL_SOCKET,SO_REUSEADDR,&On,sizeof(On));
+  NMEA0183EnableRxTime(fd);
+  bool result=( bind(fd,(struct sockaddr *)&Addr,sizeof(Addr))==0 );
+  if ( result && MulticastGroup!=0 ) {
+    struct ip_mreq mreq;
+    mreq.imr_multiaddr=Addr.sin_addr;
+    mreq.imr_interface=Local;
+    result=( setsockopt(fd,IPPROTO_IP,IP_ADD_MEMBERSHIP,&mreq,sizeof(mreq))==0 );
+  }
+  if ( !result ) {
+    Close();
+    return false;
+  }
+
+  if ( Buffers==0 ) Buffers=new char[MAX_NMEA0183_UDP_BATCH*MAX_NMEA0183_UDP_DATAGRAM_LEN];
+
+  return true;
+}
+
+//*****************************************************************************
+void tNMEA0183UdpReceiver::Close() {
+  if ( fd!=-1 ) close(fd);
+  fd=-1;
+}
+
+//*****************************************************************************
+uint16_t tNMEA0183UdpReceiver::GetPort() const {
+  struct sockaddr_in Addr;
+  socklen_t len=sizeof(Addr);
+
+  if ( fd==-1 || getsockname(fd,(struct sockaddr *)&Addr,&len)!=0 ) return 0;
+
+  return ntohs(Addr.sin_port);
+}
+
+//*****************************************************************************
+tNMEA0183 *tNMEA0183UdpReceiver::FindSender(const struct sockaddr_in &Addr) {
+  for ( uint8_t i=0; i<SenderCount; i++ ) {
+    if ( Senders[i].Addr.sin_addr.s_addr==Addr.sin_addr.s_addr && Senders[i].Addr.sin_port==Addr.sin_port ) {
+      return Senders[i].NMEA0183;
+    }
+  }
+
+  if ( SenderCount==MAX_NMEA0183_UDP_SENDERS ) return 0;
+
+  tSender &Sender=Senders[SenderCount];
+  Sender.Addr=Addr;
+  Sender.NMEA0183=new tNMEA0183(0,FirstSourceID+SenderCount);
+  Sender.NMEA0183->SetMsgHandler(MsgHandler);
+  SenderCount++;
+
+  return Sender.NMEA0183;
+}
+
+//*****************************************************************************
+size_t tNMEA0183UdpReceiver::Receive() {
+  struct mmsghdr Msgs[MAX_NMEA0183_UDP_BATCH];
+  struct iovec iov[MAX_NMEA0183_UDP_BATCH];
+  struct sockaddr_in Addrs[MAX_NMEA0183_UDP_BATCH];
+  union { // Aligned control buffers for receive timestamps
+    char Buf[NMEA0183_RX_TIME_CONTROL_LEN];
+    struct cmsghdr Align;
+  } Controls[MAX_NMEA0183_UDP_BATCH];
+  size_t MsgCount=0;
+
+  if ( fd==-1 ) return 0;
+
+  for (;;) {
+    memset(Msgs,0,sizeof(Msgs));
+    for ( int i=0; i<MAX_NMEA0183_UDP_BATCH; i++ ) {
+      iov[i].iov_base=Buffers+i*MAX_NMEA0183_UDP_DATAGRAM_LEN;
+      iov[i].iov_len=MAX_NMEA0183_UDP_DATAGRAM_LEN;
+      Msgs[i].msg_hdr.msg_iov=&iov[i];
+      Msgs[i].msg_hdr.msg_iovlen=1;
+      Msgs[i].msg_hdr.msg_name=&Addrs[i];
+      Msgs[i].msg_hdr.msg_namelen=sizeof(Addrs[i]);
+      Msgs[i].msg_hdr.msg_control=Controls[i].Buf;
+      Msgs[i].msg_hdr.msg_controllen=sizeof(Controls[i].Buf);
+    }
+
+    int n=recvmmsg(fd,Msgs,MAX_NMEA0183_UDP_BATCH,MSG_DONTWAIT,0);
+    if ( n<=0 ) break;  // EAGAIN, nothing more to read
+
+    for ( int i=0; i<n; i++ ) {
+      if ( Msgs[i].msg_hdr.msg_flags & MSG_TRUNC ) { // Rest of datagram has been lost
+        Truncated++;
+        continue;
+      }
+      tNMEA0183 *NMEA0183=FindSender(Addrs[i]);
+      if ( NMEA0183==0 ) {
+        Dropped++;
+        continue;
+      }
+      NMEA0183->ResetReceive();  // Sentences do not continue over datagrams
+      NMEA0183->SetFeedTime(NMEA0183GetRxTime(&Msgs[i].msg_hdr));
+      MsgCount+=NMEA0183->Feed((const char *)iov[i].iov_base,Msgs[i].msg_len);
+    }
+    if ( n<MAX_NMEA0183_UDP_BATCH ) break;
+  }
+
+  return MsgCount;
+}
+
+//*****************************************************************************
+bool tNMEA0183UdpReceiver::GetSender(uint8_t SourceID, struct sockaddr_in &Addr) const {
+  uint8_t i=SourceID-FirstSourceID;
+
+  if ( i>=SenderCount ) return false;
+
+  Addr=Senders[i].Addr;
+  return true;
+}
+
+#endif
@@ -0,0 +1,95 @@
+/*
+NMEA0183Udp.h
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+UDP receiver for NMEA0183 multiplexers sending to port 10110. Receiver reads
+many datagrams with one recvmmsg(2) call and feeds each datagram to message
+framing of its sender. Each sender address gets own SourceID, so messages
+from different devices can be separated. Each datagram must contain whole
+sentences, so sentence left incomplete at end of datagram is dropped. Unicast,
+broadcast and multicast IPv4 are supported. Messages get kernel receive time of their datagram
+as RxTime.
+
+Only for Linux.
+*/
+
+#ifndef _NMEA0183UDP_H_
+#define _NMEA0183UDP_H_
+
+#if defined(__linux__)||defined(__linux)||defined(linux)
+#include <netinet/in.h>
+#include "NMEA0183.h"
+
+#define MAX_NMEA0183_UDP_SENDERS 16     // Senders with own SourceID
+#define MAX_NMEA0183_UDP_BATCH 16       // Datagrams read on one recvmmsg call
+#define MAX_NMEA0183_UDP_DATAGRAM_LEN 2048
+#define NMEA0183_UDP_PORT 10110
+
+//------------------------------------------------------------------------------
+class tNMEA0183UdpReceiver
+{
+  protected:
+    struct tSender {
+      struct sockaddr_in Addr;
+      tNMEA0183 *NMEA0183;  // Framing for sender. Allocated on first datagram.
+    };
+
+    int fd;
+    tNMEA0183::tMsgHandler MsgHandler;
+    uint8_t FirstSourceID;
+    tSender Senders[MAX_NMEA0183_UDP_SENDERS];
+    uint8_t SenderCount;
+    uint32_t Dropped;
+    uint32_t Truncated;
+    char *Buffers; // MAX_NMEA0183_UDP_BATCH datagram buffers
+
+    tNMEA0183 *FindSender(const struct sockaddr_in &Addr);
+
+  public:
+    // Messages will be given to MsgHandler with SourceID FirstSourceID+sender index.
+    tNMEA0183UdpReceiver(tNMEA0183::tMsgHandler _MsgHandler=0, uint8_t _FirstSourceID=0);
+    ~tNMEA0183UdpReceiver();
+    tNMEA0183UdpReceiver(const tNMEA0183UdpReceiver &)=delete;
+    tNMEA0183UdpReceiver &operator=(const tNMEA0183UdpReceiver &)=delete;
+
+    // Open non blocking socket bound to Port. If MulticastGroup is given, group will
+    // be joined on interface of LocalAddress (0 for default). Without group
+    // LocalAddress 0 receives unicast and broadcast on all interfaces.
+    bool Open(uint16_t Port=NMEA0183_UDP_PORT, const char *MulticastGroup=0, const char *LocalAddress=0);
+    void Close();
+    bool IsOpen() const { return fd!=-1; }
+    // Bound port. Useful, when socket has been opened with port 0.
+    uint16_t GetPort() const;
+    // Socket descriptor for poll or epoll.
+    int GetReadFd() const { return fd; }
+    // Read all waiting datagrams and feed them. Returns count of received messages.
+    size_t Receive();
+    // Get address of sender with SourceID. Returns false for unknown SourceID.
+    bool GetSender(uint8_t SourceID, struct sockaddr_in &Addr) const;
+    // Count of datagrams dropped, since there was no room for new sender.
+    uint32_t GetDropped() const { return Dropped; }
+    // Count of datagrams dropped, since they were longer than MAX_NMEA0183_UDP_DATAGRAM_LEN.
+    uint32_t GetTruncated() const { return Truncated; }
+};
+
+#endif
+
+#endif
@@ -0,0 +1,326 @@
+/*
+NMEA0183Uring.cpp
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#include "NMEA0183Uring.h"
+
+#ifdef NMEA0183_HAS_URING
+
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <linux/io_uring.h>
+
+#define NMEA0183_URING_POLL_FLAG 1              // user_data flag for poll request
+#define NMEA0183_URING_CANCEL_DATA (~(__u64)0)  // user_data for cancel request
+
+//*****************************************************************************
+tNMEA0183UringReader::tNMEA0183UringReader(size_t _MaxSources, size_t _BufSize)
+: RingFd(-1), SqRing(MAP_FAILED), SqRingSize(0), CqRing(MAP_FAILED), CqRingSize(0),
+  Sqes((struct io_uring_sqe *)MAP_FAILED), SqesSize(0), SqPending(0),
+  Buffers((char *)MAP_FAILED), BufSize(_BufSize), FixedBuffers(false), MaxSources(_MaxSources) {
+  Sources=new tSource[MaxSources];
+  for ( size_t i=0; i<MaxSources; i++ ) {
+    Sources[i].State=ssFree;
+    Sources[i].InFlight=false;
+    Sources[i].Polling=false;
+  }
+
+  // Buffers are mapped, so that pages are not reused by heap, if kernel still
+  // owns them after ring has been closed.
+  Buffers=(char *)mmap(0,MaxSources*BufSize,PROT_READ | PROT_WRITE,MAP_PRIVATE | MAP_ANONYMOUS,-1,0);
+  if ( Buffers==MAP_FAILED || !Setup(2*MaxSources) ) return;
+
+  struct iovec *iov=new struct iovec[MaxSources];
+  for ( size_t i=0; i<MaxSources; i++ ) {
+    iov[i].iov_base=Buffers+i*BufSize;
+    iov[i].iov_len=BufSize;
+  }
+  FixedBuffers=( syscall(__NR_io_uring_register,RingFd,IORING_REGISTER_BUFFERS,iov,MaxSources)==0 );
+  delete[] iov;
+}
+
+//*****************************************************************************
+tNMEA0183UringReader::~tNMEA0183UringReader() {
+  bool InFlight=false;
+
+  if ( RingFd!=-1 ) {
+    // Kernel may still write to buffers, so cancel requests and wait them done.
+    for ( size_t i=0; i<MaxSources; i++ ) {
+      if ( Sources[i].State==ssActive ) {
+        if ( !Sources[i].InFlight || !Cancel(i) ) Sources[i].State=ssFree;
+      }
+    }
+    for ( int Try=0; Try<100; Try++ ) {
+      InFlight=false;
+      for ( size_t i=0; i<MaxSources && !InFlight; i++ ) InFlight=( Sources[i].State!=ssFree && Sources[i].InFlight );
+      if ( !InFlight ) break;
+      Poll(10);
+    }
+    close(RingFd);
+  }
+  if ( Sqes!=MAP_FAILED ) munmap(Sqes,SqesSize);
+  if ( CqRing!=MAP_FAILED && CqRing!=SqRing ) munmap(CqRing,CqRingSize);
+  if ( SqRing!=MAP_FAILED ) munmap(SqRing,SqRingSize);
+  // Buffer with request still in flight is left mapped rather than given to reuse.
+  if ( Buffers!=MAP_FAILED && !InFlight ) munmap(Buffers,MaxSources*BufSize);
+  delete[] Sources;
+}
+
+//*****************************************************************************
+bool tNMEA0183UringReader::Setup(unsigned Entries) {
+  struct io_uring_params p;
+
+  memset(&p,0,sizeof(p));
+  int fd=syscall(__NR_io_uring_setup,Entries,&p);
+  if ( fd<0 ) return false;
+  if ( !(p.features & IORING_FEAT_EXT_ARG) ) {
+    close(fd);
+    return false;
+  }
+
+  SqRingSize=p.sq_off.array+p.sq_entries*sizeof(unsigned);
+  CqRingSize=p.cq_off.cqes+p.cq_entries*sizeof(struct io_uring_cqe);
+  if ( p.features & IORING_FEAT_SINGLE_MMAP ) {
+    if ( CqRingSize>SqRingSize ) SqRingSize=CqRingSize;
+    CqRingSize=SqRingSize;
+  }
+  SqRing=mmap(0,SqRingSize,PROT_READ | PROT_WRITE,MAP_SHARED | MAP_POPULATE,fd,IORING_OFF_SQ_RING);
+  if ( SqRing==MAP_FAILED ) { close(fd); return false; }
+  if ( p.features & IORING_FEAT_SINGLE_MMAP ) {
+    CqRing=SqRing;
+  } else {
+    CqRing=mmap(0,CqRingSize,PROT_READ | PROT_WRITE,MAP_SHARED | MAP_POPULATE,fd,IORING_OFF_CQ_RING);
+    if ( CqRing==MAP_FAILED ) { close(fd); return false; }
+  }
+  SqesSize=p.sq_entries*sizeof(struct io_uring_sqe);
+  Sqes=(struct io_uring_sqe *)mmap(0,SqesSize,PROT_READ | PROT_WRITE,MAP_SHARED | MAP_POPULATE,fd,IORING_OFF_SQES);
+  if ( Sqes==MAP_FAILED ) { close(fd); return false; }
+
+  char *sq=(char *)SqRing;
+  SqHead=(unsigned *)(sq+p.sq_off.head);
+  SqTail=(unsigned *)(sq+p.sq_off.tail);
+  SqMask=*(unsigned *)(sq+p.sq_off.ring_mask);
+  SqArray=(unsigned *)(sq+p.sq_off.array);
+  char *cq=(char *)CqRing;
+  CqHead=(unsigned *)(cq+p.cq_off.head);
+  CqTail=(unsigned *)(cq+p.cq_off.tail);
+  CqMask=*(unsigned *)(cq+p.cq_off.ring_mask);
+  Cqes=(struct io_uring_cqe *)(cq+p.cq_off.cqes);
+  RingFd=fd;
+
+  return true;
+}
+
+//*****************************************************************************
+struct io_uring_sqe *tNMEA0183UringReader::GetSqe() {
+  unsigned Tail=*SqTail;
+
+  if ( Tail-__atomic_load_n(SqHead,__ATOMIC_ACQUIRE)>SqMask ) { // Full, so submit prepared ones
+    if ( !Submit(0,0) || Tail-__atomic_load_n(SqHead,__ATOMIC_ACQUIRE)>SqMask ) return 0;
+  }
+
+  struct io_uring_sqe *sqe=&Sqes[Tail & SqMask];
+  memset(sqe,0,sizeof(*sqe));
+  SqArray[Tail & SqMask]=Tail & SqMask;
+  __atomic_store_n(SqTail,Tail+1,__ATOMIC_RELEASE);
+  SqPending++;
+
+  return sqe;
+}
+
+//*****************************************************************************
+bool tNMEA0183UringReader::Submit(unsigned WaitCount, int TimeoutMs) {
+  struct io_uring_getevents_arg arg;
+  struct __kernel_timespec ts;
+  unsigned Flags=IORING_ENTER_EXT_ARG;
+
+  memset(&arg,0,sizeof(arg));
+  if ( WaitCount>0 ) {
+    Flags|=IORING_ENTER_GETEVENTS;
+    if ( TimeoutMs>=0 ) {
+      ts.tv_sec=TimeoutMs/1000;
+      ts.tv_nsec=(TimeoutMs%1000)*1000000L;
+      arg.ts=(__u64)(uintptr_t)&ts;
+    }
+  }
+
+  int res=syscall(__NR_io_uring_enter,RingFd,SqPending,WaitCount,Flags,&arg,sizeof(arg));
+  if ( res<0 ) return ( errno==ETIME || errno==EINTR );
+  SqPending-=( (unsigned)res<SqPending?res:SqPending );
+
+  return true;
+}
+
+//*****************************************************************************
+bool tNMEA0183UringReader::ArmRead(size_t Index) {
+  struct io_uring_sqe *sqe=GetSqe();
+  if ( sqe==0 ) return false;
+
+  sqe->opcode=( FixedBuffers?IORING_OP_READ_FIXED:IORING_OP_READ );
+  sqe->fd=Sources[Index].fd;
+  sqe->addr=(__u64)(uintptr_t)(Buffers+Index*BufSize);
+  sqe->len=BufSize;
+  sqe->off=(__u64)-1;  // Current position, as for read(2) on streams
+  sqe->buf_index=Index;
+  sqe->user_data=Index<<1;
+  Sources[Index].InFlight=true;
+  Sources[Index].Polling=false;
+
+  return true;
+}
+
+//*****************************************************************************
+bool tNMEA0183UringReader::ArmPoll(size_t Index) {
+  struct io_uring_sqe *sqe=GetSqe();
+  if ( sqe==0 ) return false;
+
+  sqe->opcode=IORING_OP_POLL_ADD;
+  sqe->fd=Sources[Index].fd;
+  sqe->poll32_events=POLLIN;
+  sqe->user_data=(Index<<1) | NMEA0183_URING_POLL_FLAG;
+  Sources[Index].InFlight=true;
+  Sources[Index].Polling=true;
+
+  return true;
+}
+
+//*****************************************************************************
+// Cancel request in flight. Slot is freed on its completion.
+bool tNMEA0183UringReader::Cancel(size_t Index) {
+  struct io_uring_sqe *sqe=GetSqe();
+  if ( sqe==0 ) return false;
+
+  sqe->opcode=IORING_OP_ASYNC_CANCEL;
+  sqe->fd=-1;
+  sqe->addr=(Index<<1) | ( Sources[Index].Polling?NMEA0183_URING_POLL_FLAG:0 );
+  sqe->user_data=NMEA0183_URING_CANCEL_DATA;
+  Sources[Index].State=ssRemoving;
+
+  return true;
+}
+
+//*****************************************************************************
+bool tNMEA0183UringReader::Add(int fd, tNMEA0183Base *NMEA0183, tFeedPort _FeedPort) {
+  if ( RingFd==-1 || fd<0 || NMEA0183==0 ) return false;
+
+  size_t i;
+  for ( i=0; i<MaxSources && Sources[i].State!=ssFree; i++ );
+  if ( i==MaxSources ) return false;
+
+  Sources[i].NMEA0183=NMEA0183;
+  Sources[i].FeedPort=_FeedPort;
+  Sources[i].fd=fd;
+  Sources[i].State=ssActive;
+  if ( !ArmRead(i) ) {
+    Sources[i].State=ssFree;
+    return false;
+  }
+
+  return Submit(0,0);
+}
+
+//*****************************************************************************
+bool tNMEA0183UringReader::Remove(tNMEA0183Base *NMEA0183) {
+  for ( size_t i=0; i<MaxSources; i++ ) {
+    if ( Sources[i].State==ssActive && Sources[i].NMEA0183==NMEA0183 ) {
+      if ( !Sources[i].InFlight ) { // Nothing to cancel
+        Sources[i].State=ssFree;
+        return true;
+      }
+      if ( !Cancel(i) ) return false;
+      Submit(0,0);  // On failure cancel stays pending and is submitted by next Poll
+      return true;
+    }
+  }
+
+  return false;
+}
+
+//*****************************************************************************
+size_t tNMEA0183UringReader::Poll(int TimeoutMs) {
+  size_t MsgCount=0;
+
+  if ( RingFd==-1 ) return 0;
+
+  unsigned Head=*CqHead;
+  if ( Head==__atomic_load_n(CqTail,__ATOMIC_ACQUIRE) ) {
+    if ( !Submit((TimeoutMs!=0?1:0),TimeoutMs) ) return 0;
+  }
+
+  for ( ; Head!=__atomic_load_n(CqTail,__ATOMIC_ACQUIRE); Head++ ) {
+    struct io_uring_cqe *cqe=&Cqes[Head & CqMask];
+    if ( cqe->user_data==NMEA0183_URING_CANCEL_DATA ) continue;
+
+    size_t i=cqe->user_data>>1;
+    if ( i>=MaxSources ) continue;
+    tSource &Source=Sources[i];
+    int res=cqe->res;
+
+    if ( Source.State==ssFree ) continue;
+    Source.InFlight=false;
+
+    if ( Source.State==ssRemoving ) { // Request has been completed or cancelled
+      Source.State=ssFree;
+      continue;
+    }
+    if ( Source.State!=ssActive ) continue;
+
+    bool Armed;
+    if ( cqe->user_data & NMEA0183_URING_POLL_FLAG ) { // Data available
+      Armed=( res>=0 && ArmRead(i) );
+    } else if ( res>0 ) {
+      MsgCount+=Source.FeedPort(Source.NMEA0183,Buffers+i*BufSize,res);
+      // Handler may have removed source and even added new one to same slot.
+      Armed=( Source.State!=ssActive || Source.InFlight?true:ArmRead(i) );
+    } else if ( res==-EAGAIN ) { // Non blocking descriptor without data
+      Armed=ArmPoll(i);
+    } else if ( res==-EINTR ) {
+      Armed=ArmRead(i);
+    } else { // End of file or error
+      Armed=false;
+    }
+    if ( !Armed && Source.State==ssActive ) Source.State=ssFree;
+  }
+  __atomic_store_n(CqHead,Head,__ATOMIC_RELEASE);
+
+  if ( SqPending>0 ) Submit(0,0);
+
+  return MsgCount;
+}
+
+//*****************************************************************************
+size_t tNMEA0183UringReader::SourceCount() const {
+  size_t Count=0;
+
+  for ( size_t i=0; i<MaxSources; i++ ) if ( Sources[i].State==ssActive ) Count++;
+
+  return Count;
+}
+
+#endif
@@ -0,0 +1,128 @@
+/*
+NMEA0183Uring.h
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+io_uring(7) reader for Linux. Reader keeps one read for each source in flight
+on registered buffer, so there is no system call per read. Completed buffers
+are given directly to tNMEA0183::Feed. Reader uses raw io_uring system calls,
+so liburing is not needed. Kernel must support IORING_FEAT_EXT_ARG (5.11).
+
+Reader is available, when linux/io_uring.h exists.
+*/
+
+#ifndef _NMEA0183URING_H_
+#define _NMEA0183URING_H_
+
+#if defined(__linux__)||defined(__linux)||defined(linux)
+#if defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define NMEA0183_HAS_URING
+#endif
+#endif
+#endif
+
+#ifdef NMEA0183_HAS_URING
+#include "NMEA0183.h"
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+//------------------------------------------------------------------------------
+class tNMEA0183UringReader
+{
+  protected:
+    typedef size_t (*tFeedPort)(tNMEA0183Base *NMEA0183, const char *data, size_t len);
+    enum tSourceState { ssFree, ssActive, ssRemoving };
+    struct tSource {
+      tNMEA0183Base *NMEA0183;
+      tFeedPort FeedPort;  // Calls Feed of typed tNMEA0183T
+      int fd;
+      uint8_t State;
+      bool InFlight;       // Read or poll request has been submitted and not completed
+      bool Polling;        // Request in flight is poll
+    };
+
+    int RingFd;
+    // Submission and completion ring memory shared with kernel
+    void *SqRing;
+    size_t SqRingSize;
+    void *CqRing;
+    size_t CqRingSize;
+    struct io_uring_sqe *Sqes;
+    size_t SqesSize;
+    unsigned *SqHead;
+    unsigned *SqTail;
+    unsigned SqMask;
+    unsigned *SqArray;
+    unsigned *CqHead;
+    unsigned *CqTail;
+    unsigned CqMask;
+    struct io_uring_cqe *Cqes;
+    unsigned SqPending;     // Prepared entries not yet submitted
+    // One buffer for each source. Buffers are registered to kernel, if possible.
+    char *Buffers;
+    size_t BufSize;
+    bool FixedBuffers;
+    tSource *Sources;
+    size_t MaxSources;
+
+    template<class tNMEA0183Type>
+    static size_t FeedPort(tNMEA0183Base *NMEA0183, const char *data, size_t len) { return static_cast<tNMEA0183Type *>(NMEA0183)->Feed(data,len); }
+    bool Add(int fd, tNMEA0183Base *NMEA0183, tFeedPort _FeedPort);
+    bool Setup(unsigned Entries);
+    struct io_uring_sqe *GetSqe();
+    bool Submit(unsigned WaitCount, int TimeoutMs);
+    bool ArmRead(size_t Index);
+    bool ArmPoll(size_t Index);
+    bool Cancel(size_t Index);
+
+  public:
+    // Create reader for MaxSources sources. Each source gets BufSize bytes buffer.
+    tNMEA0183UringReader(size_t _MaxSources=16, size_t _BufSize=4096);
+    // Requests in flight are cancelled and waited before buffers are released.
+    ~tNMEA0183UringReader();
+    tNMEA0183UringReader(const tNMEA0183UringReader &)=delete;
+    tNMEA0183UringReader &operator=(const tNMEA0183UringReader &)=delete;
+
+    // Check was io_uring set up. It may be disabled by kernel or system policy.
+    bool IsOpen() const { return RingFd!=-1; }
+    // Check are reads done to registered buffers.
+    bool HasFixedBuffers() const { return FixedBuffers; }
+    // Read descriptor fd and feed data to NMEA0183. Descriptor is not closed by reader.
+    // Returns false, if there is no room or reader is not open.
+    template<uint16_t MsgLen, uint16_t MaxFields>
+    bool Add(int fd, tNMEA0183T<MsgLen,MaxFields> *NMEA0183) {
+      return Add(fd,NMEA0183,&FeedPort<tNMEA0183T<MsgLen,MaxFields> >);
+    }
+    // Stop reading source. Read in flight is cancelled and slot is freed on
+    // its completion. Without request in flight (e.g. when called from message
+    // handler of source) slot is freed immediately.
+    bool Remove(tNMEA0183Base *NMEA0183);
+    // Wait up to TimeoutMs (-1 forever) for completed reads and feed them. Sources,
+    // which reach end of file or fail, are removed. Returns count of received messages.
+    size_t Poll(int TimeoutMs);
+    // Count of sources being read.
+    size_t SourceCount() const;
+};
+
+#endif
+
+#endif
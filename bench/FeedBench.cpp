@@ -0,0 +1,180 @@
+/*
+FeedBench.cpp
+
+The MIT License
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+// \brief Compares tNMEA0183::ParseMessages on byte and block streams with tNMEA0183::Feed.
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <string.h>
+#include <NMEA0183.h>
+#include <NMEA0183Scan.h>
+
+static const char *Sentences[]={
+  "$GPRMC,092348.00,A,6035.04228,N,02115.15472,E,0.01,272.61,060815,7.2,E,D*34\r\n",
+  "$GPGGA,182435.00,6023.20859,N,02219.99442,E,2,10,0.9,4.0,M,20.6,M,5.0,0120*4D\r\n",
+  "$IIDPT,10.5,0.9*7D\r\n",
+  "$GPZDA,160012.71,11,03,2004,-1,00*7D\r\n",
+  "!AIVDM,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0*5C\r\n"
+};
+
+//-----------------------------------------------------------------------------
+// Stream reading from memory one byte at time as port streams do.
+class tMemoryStream : public tNMEA0183Stream {
+protected:
+  const char *Data;
+  size_t Len;
+  size_t Pos;
+public:
+  tMemoryStream(const char *_Data, size_t _Len) : Data(_Data), Len(_Len), Pos(0) {}
+  void Rewind() { Pos=0; }
+  int available() { return Len-Pos; }
+  int read() { return ( Pos<Len?(uint8_t)Data[Pos++]:-1 ); }
+  size_t write(const uint8_t* data, size_t size) { (void)data; return size; }
+};
+
+//-----------------------------------------------------------------------------
+// Stream reading from memory in blocks.
+class tBlockMemoryStream : public tMemoryStream {
+public:
+  tBlockMemoryStream(const char *_Data, size_t _Len) : tMemoryStream(_Data,_Len) {}
+  using tMemoryStream::read;
+  size_t read(uint8_t *buf, size_t max) {
+    if ( max>Len-Pos ) max=Len-Pos;
+    memcpy(buf,Data+Pos,max);
+    Pos+=max;
+    return max;
+  }
+};
+
+static size_t MsgCount=0;
+
+static void CountMessage(const tNMEA0183Msg &NMEA0183Msg) {
+  (void)NMEA0183Msg;
+  MsgCount++;
+}
+
+static void CountMessages(const tNMEA0183Msg *NMEA0183Msgs, size_t Count) {
+  (void)NMEA0183Msgs;
+  MsgCount+=Count;
+}
+
+static void Report(const char *Name, size_t bytes, double secs) {
+  printf("%-24s %10.0f sentences/s %8.1f MB/s\n",Name,MsgCount/secs,bytes/secs/1e6);
+}
+
+int main(int argc, char **argv) {
+  size_t Rounds=(argc>1?atoi(argv[1]):200000);
+  std::string Data;
+
+  for (size_t i=0; i<Rounds; i++) {
+    Data+=Sentences[i%(sizeof(Sentences)/sizeof(Sentences[0]))];
+  }
+
+  {
+    tMemoryStream Stream(Data.data(),Data.size());
+    tNMEA0183 NMEA0183(&Stream);
+    NMEA0183.SetMsgHandler(CountMessage);
+    NMEA0183.Open();
+    MsgCount=0;
+    auto start=std::chrono::steady_clock::now();
+    NMEA0183.ParseMessages();
+    std::chrono::duration<double> secs=std::chrono::steady_clock::now()-start;
+    Report("ParseMessages",Data.size(),secs.count());
+  }
+
+  {
+    tBlockMemoryStream Stream(Data.data(),Data.size());
+    tNMEA0183 NMEA0183(&Stream);
+    NMEA0183.SetMsgHandler(CountMessage);
+    NMEA0183.Open();
+    MsgCount=0;
+    auto start=std::chrono::steady_clock::now();
+    NMEA0183.ParseMessages();
+    std::chrono::duration<double> secs=std::chrono::steady_clock::now()-start;
+    Report("ParseMessages (block)",Data.size(),secs.count());
+  }
+
+  {
+    const size_t ChunkSize=1460;
+    tNMEA0183 NMEA0183;
+    MsgCount=0;
+    auto start=std::chrono::steady_clock::now();
+    for (size_t i=0; i<Data.size(); i+=ChunkSize) {
+      NMEA0183.Feed(Data.data()+i,(Data.size()-i<ChunkSize?Data.size()-i:ChunkSize),CountMessage);
+    }
+    std::chrono::duration<double> secs=std::chrono::steady_clock::now()-start;
+    Report("Feed",Data.size(),secs.count());
+  }
+
+  {
+    const size_t ChunkSize=1460;
+    tNMEA0183 NMEA0183;
+    NMEA0183.SetMsgBatchHandler(CountMessages,64);
+    MsgCount=0;
+    auto start=std::chrono::steady_clock::now();
+    for (size_t i=0; i<Data.size(); i+=ChunkSize) {
+      NMEA0183.Feed(Data.data()+i,(Data.size()-i<ChunkSize?Data.size()-i:ChunkSize));
+    }
+    std::chrono::duration<double> secs=std::chrono::steady_clock::now()-start;
+    Report("Feed (batch)",Data.size(),secs.count());
+  }
+
+  {
+    // Only RMC and GGA are wanted. Others are dropped after header.
+    const size_t ChunkSize=1460;
+    tNMEA0183 NMEA0183;
+    NMEA0183.Subscribe("RMC");
+    NMEA0183.Subscribe("GGA");
+    MsgCount=0;
+    auto start=std::chrono::steady_clock::now();
+    for (size_t i=0; i<Data.size(); i+=ChunkSize) {
+      NMEA0183.Feed(Data.data()+i,(Data.size()-i<ChunkSize?Data.size()-i:ChunkSize),CountMessage);
+    }
+    std::chrono::duration<double> secs=std::chrono::steady_clock::now()-start;
+    Report("Feed (subscribed)",Data.size(),secs.count());
+  }
+
+  {
+    // Noisy line with garbage between sentences.
+    std::string NoisyData;
+    for (size_t i=0; i<Rounds; i++) {
+      NoisyData+="\x01\x7f noise noise noise noise noise noise noise noise noise noise \r\n";
+      NoisyData+=Sentences[i%(sizeof(Sentences)/sizeof(Sentences[0]))];
+    }
+    const size_t ChunkSize=1460;
+    tNMEA0183 NMEA0183;
+    MsgCount=0;
+    auto start=std::chrono::steady_clock::now();
+    for (size_t i=0; i<NoisyData.size(); i+=ChunkSize) {
+      NMEA0183.Feed(NoisyData.data()+i,(NoisyData.size()-i<ChunkSize?NoisyData.size()-i:ChunkSize),CountMessage);
+    }
+    std::chrono::duration<double> secs=std::chrono::steady_clock::now()-start;
+    Report("Feed (noisy)",NoisyData.size(),secs.count());
+  }
+
+  printf("Scan method: %s\n",NMEA0183ScanMethod());
+
+  return 0;
+}
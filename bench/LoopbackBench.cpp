@@ -0,0 +1,157 @@
+/*
+LoopbackBench.cpp
+
+The MIT License
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+// \brief Sends sentences with tNMEA0183::SendMessage and receives them with ParseMessages
+// through memory ring and pty pair. Usage: LoopbackBench [sentences]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include <string.h>
+#include <poll.h>
+#include <NMEA0183.h>
+#include <NMEA0183MemoryStream.h>
+#include <NMEA0183PtyStream.h>
+#include <NMEA0183SerialStream.h>
+
+static const char *Sentences[]={
+  "$GPRMC,092348.00,A,6035.04228,N,02115.15472,E,0.01,272.61,060815,7.2,E,D*34",
+  "$GPGGA,182435.00,6023.20859,N,02219.99442,E,2,10,0.9,4.0,M,20.6,M,5.0,0120*4D",
+  "$IIDPT,10.5,0.9*7D",
+  "$GPZDA,160012.71,11,03,2004,-1,00*7D",
+  "!AIVDM,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0*5C"
+};
+static const size_t SentenceCount=sizeof(Sentences)/sizeof(Sentences[0]);
+
+static size_t MsgCount=0;
+
+static void CountMessage(const tNMEA0183Msg &NMEA0183Msg) {
+  (void)NMEA0183Msg;
+  MsgCount++;
+}
+
+static void Report(const char *Name, size_t Count, double secs) {
+  size_t Bytes=0;
+  for (size_t i=0; i<MsgCount; i++) Bytes+=strlen(Sentences[i%SentenceCount])+2;
+  printf("%-24s %10.0f sentences/s %8.1f MB/s%s\n",Name,MsgCount/secs,Bytes/secs/1e6,
+         (MsgCount==Count?"":" (lost sentences)"));
+}
+
+// Send Count messages. When sender can not buffer more, wait that its stream
+// can be written.
+static void Send(tNMEA0183 &Sender, const std::vector<tNMEA0183Msg> &Msgs, size_t Count) {
+  for (size_t i=0; i<Count; i++) {
+    while ( !Sender.SendMessage(Msgs[i%Msgs.size()]) ) {
+      struct pollfd pfd={Sender.GetWriteFd(),POLLOUT,0};
+      if ( pfd.fd!=-1 ) poll(&pfd,1,10); else std::this_thread::yield();
+      Sender.OnWritable();
+    }
+  }
+  while ( !Sender.OnWritable() ) {
+    struct pollfd pfd={Sender.GetWriteFd(),POLLOUT,0};
+    if ( pfd.fd!=-1 ) poll(&pfd,1,10); else std::this_thread::yield();
+  }
+}
+
+// Parse until Count messages has been received or nothing comes in 1 s.
+static void Receive(tNMEA0183 &Receiver, size_t Count) {
+  auto LastMsg=std::chrono::steady_clock::now();
+  while ( MsgCount<Count && Receiver.WaitForData(1000) ) {
+    size_t Prev=MsgCount;
+    Receiver.ParseMessages();
+    if ( MsgCount!=Prev ) {
+      LastMsg=std::chrono::steady_clock::now();
+    } else if ( std::chrono::steady_clock::now()-LastMsg>std::chrono::seconds(1) ) {
+      break;
+    } else {
+      std::this_thread::yield();  // Memory stream has no descriptor to wait
+    }
+  }
+}
+
+static void RunThreaded(const char *Name, tNMEA0183 &Sender, tNMEA0183 &Receiver,
+                        const std::vector<tNMEA0183Msg> &Msgs, size_t Count) {
+  MsgCount=0;
+  auto start=std::chrono::steady_clock::now();
+  std::thread SendThread(Send,std::ref(Sender),std::cref(Msgs),Count);
+  Receive(Receiver,Count);
+  SendThread.join();
+  std::chrono::duration<double> secs=std::chrono::steady_clock::now()-start;
+  Report(Name,Count,secs.count());
+}
+
+int main(int argc, char **argv) {
+  size_t Count=(argc>1?atoi(argv[1]):2000000);
+  std::vector<tNMEA0183Msg> Msgs(SentenceCount);
+
+  for (size_t i=0; i<SentenceCount; i++) Msgs[i].SetMessage(Sentences[i]);
+
+  {
+    // Same object sends and receives on one thread.
+    tNMEA0183MemoryStream Stream(65536);
+    tNMEA0183 NMEA0183(&Stream);
+    NMEA0183.SetMsgHandler(CountMessage);
+    NMEA0183.Open();
+    MsgCount=0;
+    auto start=std::chrono::steady_clock::now();
+    for (size_t i=0; i<Count; i++) {
+      while ( !NMEA0183.SendMessage(Msgs[i%SentenceCount]) ) NMEA0183.ParseMessages();
+    }
+    while ( NMEA0183.HasPendingOutput() || Stream.available()>0 ) {
+      NMEA0183.OnWritable();
+      NMEA0183.ParseMessages();
+    }
+    std::chrono::duration<double> secs=std::chrono::steady_clock::now()-start;
+    Report("Memory",Count,secs.count());
+  }
+
+  {
+    tNMEA0183MemoryStream Stream(65536);
+    tNMEA0183 Sender(&Stream);
+    tNMEA0183 Receiver(&Stream);
+    Sender.Open();
+    Receiver.SetMsgHandler(CountMessage);
+    Receiver.Open();
+    RunThreaded("Memory (2 threads)",Sender,Receiver,Msgs,Count);
+  }
+
+  {
+    tNMEA0183PtyStream Pty;
+    tNMEA0183SerialStream Peer(Pty.GetPeerName(),115200);
+    if ( !Pty.IsOpen() || !Peer.IsOpen() ) {
+      printf("Failed to open pty\n");
+      return 1;
+    }
+    tNMEA0183 Sender(&Pty);
+    tNMEA0183 Receiver(&Peer);
+    Sender.Open();
+    Receiver.SetMsgHandler(CountMessage);
+    Receiver.Open();
+    RunThreaded("Pty (2 threads)",Sender,Receiver,Msgs,Count);
+  }
+
+  return 0;
+}
@@ -0,0 +1,121 @@
+/*
+PipelineBench.cpp
+
+The MIT License
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+// \brief Measures tNMEA0183Pipeline decoding with different worker thread counts.
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <string.h>
+#include <NMEA0183.h>
+#include <NMEA0183Messages.h>
+#include <NMEA0183Pipeline.h>
+
+static const char *Sentences[]={
+  "$GPRMC,092348.00,A,6035.04228,N,02115.15472,E,0.01,272.61,060815,7.2,E,D*34\r\n",
+  "$GPGGA,182435.00,6023.20859,N,02219.99442,E,2,10,0.9,4.0,M,20.6,M,5.0,0120*4D\r\n",
+  "$IIDPT,10.5,0.9*7D\r\n",
+  "$GPZDA,160012.71,11,03,2004,-1,00*7D\r\n",
+  "!AIVDM,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0*5C\r\n"
+};
+
+struct tDecoded {
+  double Time;
+  double Latitude;
+  double Longitude;
+};
+
+static bool Decode(const tNMEA0183Msg &Msg, tDecoded &Result) {
+  double COG,SOG,Variation;
+  unsigned long DaysSince1970;
+  int SatelliteCount,DGPSReferenceStationID;
+  double HDOP,Altitude,GeoidalSeparation,DGPSAge;
+  char Status;
+
+  if ( Msg.IsMessageCode(NMEA0183Code("RMC")) ) {
+    return NMEA0183ParseRMC_nc(Msg,Result.Time,Status,Result.Latitude,Result.Longitude,COG,SOG,DaysSince1970,Variation);
+  }
+  if ( Msg.IsMessageCode(NMEA0183Code("GGA")) ) {
+    return NMEA0183ParseGGA_nc(Msg,Result.Time,Result.Latitude,Result.Longitude,SatelliteCount,SatelliteCount,
+                               HDOP,Altitude,GeoidalSeparation,DGPSAge,DGPSReferenceStationID);
+  }
+  if ( Msg.IsMessageCode(NMEA0183Code("DPT")) ) {
+    return NMEA0183ParseDPT_nc(Msg,Result.Latitude,Result.Longitude);
+  }
+  return false;
+}
+
+static size_t MsgCount=0;
+
+static void DecodeMessage(const tNMEA0183Msg &NMEA0183Msg) {
+  tDecoded Result;
+  Decode(NMEA0183Msg,Result);
+  MsgCount++;
+}
+
+int main(int argc, char **argv) {
+  size_t Rounds=(argc>1?atoi(argv[1]):400000);
+  const size_t Sources=8;
+  const size_t ChunkSize=1460;
+  std::string Data;
+
+  for (size_t i=0; i<Rounds; i++) {
+    Data+=Sentences[i%(sizeof(Sentences)/sizeof(Sentences[0]))];
+  }
+
+  {
+    // Reference: same decoding on single thread with tNMEA0183::Feed.
+    tNMEA0183 NMEA0183;
+    MsgCount=0;
+    auto start=std::chrono::steady_clock::now();
+    for (size_t i=0; i<Data.size(); i+=ChunkSize) {
+      NMEA0183.Feed(Data.data()+i,(Data.size()-i<ChunkSize?Data.size()-i:ChunkSize),DecodeMessage);
+    }
+    std::chrono::duration<double> secs=std::chrono::steady_clock::now()-start;
+    printf("%-24s %10.0f sentences/s\n","Feed",MsgCount/secs.count());
+  }
+
+  size_t MaxThreads=std::thread::hardware_concurrency();
+  if ( MaxThreads==0 ) MaxThreads=1;
+  for (size_t Threads=1; Threads<=MaxThreads; Threads*=2) {
+    char Name[32];
+    MsgCount=0;
+    tNMEA0183Pipeline<tDecoded> Pipeline(Decode,[](const tNMEA0183Msg &, const tDecoded &, bool) { MsgCount++; },Threads);
+    auto start=std::chrono::steady_clock::now();
+    // Data is fed interleaved as if each source had own copy of 1/Sources of data.
+    size_t SourceLen=Data.size()/Sources;
+    for (size_t i=0; i<SourceLen; i+=ChunkSize) {
+      for (uint8_t s=0; s<Sources; s++) {
+        Pipeline.Feed(s,Data.data()+i,(SourceLen-i<ChunkSize?SourceLen-i:ChunkSize));
+      }
+    }
+    Pipeline.Flush();
+    std::chrono::duration<double> secs=std::chrono::steady_clock::now()-start;
+    snprintf(Name,sizeof(Name),"Pipeline (%zu threads)",Threads);
+    printf("%-24s %10.0f sentences/s\n",Name,MsgCount/secs.count());
+  }
+
+  return 0;
+}
@@ -0,0 +1,157 @@
+/*
+TcpServerBench.cpp
+
+The MIT License
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+// \brief Load generator for tNMEA0183TcpServer. Opens many loopback connections and
+// writes sentences from generator threads. Usage: TcpServerBench [connections] [sentences per connection] [workers] [generators]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <NMEA0183TcpServer.h>
+
+static const char *Sentences[]={
+  "$GPRMC,092348.00,A,6035.04228,N,02115.15472,E,0.01,272.61,060815,7.2,E,D*34\r\n",
+  "$GPGGA,182435.00,6023.20859,N,02219.99442,E,2,10,0.9,4.0,M,20.6,M,5.0,0120*4D\r\n",
+  "$IIDPT,10.5,0.9*7D\r\n",
+  "$GPZDA,160012.71,11,03,2004,-1,00*7D\r\n",
+  "!AIVDM,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0*5C\r\n"
+};
+
+static std::atomic<uint64_t> MsgCount(0);
+
+static int ConnectLoopback(uint16_t Port) {
+  struct sockaddr_in Addr;
+  memset(&Addr,0,sizeof(Addr));
+  Addr.sin_family=AF_INET;
+  Addr.sin_port=htons(Port);
+  Addr.sin_addr.s_addr=htonl(INADDR_LOOPBACK);
+  int fd=socket(AF_INET,SOCK_STREAM,0);
+  if ( fd>=0 && connect(fd,(struct sockaddr *)&Addr,sizeof(Addr))!=0 ) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+// Writes Data Rounds times to each connection. Connections are written round robin
+// in blocks, so that all connections are active at same time as on real fleet.
+static void Generate(const std::vector<int> &fds, const std::string &Data, size_t Rounds) {
+  for (size_t r=0; r<Rounds; r++) {
+    for (size_t i=0; i<fds.size(); i++) {
+      const char *p=Data.data();
+      size_t Len=Data.size();
+      while ( Len>0 ) {
+        ssize_t n=write(fds[i],p,Len);
+        if ( n<=0 ) return;
+        p+=n; Len-=n;
+      }
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  size_t Connections=(argc>1?atoi(argv[1]):1000);
+  size_t PerConnection=(argc>2?atoi(argv[2]):2000);
+  size_t Workers=(argc>3?atoi(argv[3]):0);
+  size_t Generators=(argc>4?atoi(argv[4]):2);
+  const size_t SentencesPerBlock=10;
+
+  // Each connection needs descriptor on both ends.
+  struct rlimit Limit;
+  if ( getrlimit(RLIMIT_NOFILE,&Limit)==0 && Limit.rlim_cur<Connections*2+64 ) {
+    Limit.rlim_cur=std::min<rlim_t>(Limit.rlim_max,Connections*2+64);
+    setrlimit(RLIMIT_NOFILE,&Limit);
+  }
+
+  std::string Block;
+  for (size_t i=0; i<SentencesPerBlock; i++) {
+    Block+=Sentences[i%(sizeof(Sentences)/sizeof(Sentences[0]))];
+  }
+  size_t Rounds=(PerConnection+SentencesPerBlock-1)/SentencesPerBlock;
+  uint64_t Expected=(uint64_t)Connections*Rounds*SentencesPerBlock;
+
+  tNMEA0183TcpServer Server([](const tNMEA0183Msg &, uint32_t) {
+    MsgCount.fetch_add(1,std::memory_order_relaxed);
+  },Workers,Connections);
+  if ( !Server.Open(0,"127.0.0.1") ) {
+    printf("Failed to open server\n");
+    return 1;
+  }
+
+  std::vector<std::vector<int> > fds(Generators);
+  for (size_t i=0; i<Connections; i++) {
+    int fd=ConnectLoopback(Server.GetPort());
+    if ( fd<0 ) {
+      printf("Connect failed after %zu connections\n",i);
+      return 1;
+    }
+    fds[i%Generators].push_back(fd);
+  }
+  for (int i=0; i<1000 && Server.GetConnectionCount()<Connections; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  auto start=std::chrono::steady_clock::now();
+  std::vector<std::thread> Threads;
+  for (size_t i=0; i<Generators; i++) {
+    Threads.emplace_back(Generate,std::cref(fds[i]),std::cref(Block),Rounds);
+  }
+  for (auto &t : Threads) t.join();
+  while ( MsgCount<Expected && std::chrono::steady_clock::now()-start<std::chrono::seconds(60) ) {
+    std::this_thread::sleep_for(std::chrono::microseconds(200));
+  }
+  std::chrono::duration<double> secs=std::chrono::steady_clock::now()-start;
+
+  std::vector<tNMEA0183ConnectionStats> Stats;
+  Server.GetConnectionStats(Stats);
+  uint64_t MinMessages=UINT64_MAX, MaxMessages=0, Bytes=0, Errors=0;
+  for (auto &s : Stats) {
+    MinMessages=std::min(MinMessages,s.Messages);
+    MaxMessages=std::max(MaxMessages,s.Messages);
+    Bytes+=s.Bytes;
+    Errors+=s.Errors;
+  }
+
+  printf("Workers %zu, connections %zu (%zu open), generators %zu\n",
+         Server.GetWorkerCount(),Connections,Stats.size(),Generators);
+  printf("%-24s %10.0f sentences/s %8.1f MB/s\n","TcpServer",MsgCount/secs.count(),Bytes/secs.count()/1e6);
+  printf("Received %llu/%llu sentences, %llu errors, per connection min %llu max %llu\n",
+         (unsigned long long)MsgCount.load(),(unsigned long long)Expected,(unsigned long long)Errors,
+         (unsigned long long)(Stats.empty()?0:MinMessages),(unsigned long long)MaxMessages);
+
+  for (auto &v : fds) for (int fd : v) close(fd);
+  Server.Close();
+
+  return 0;
+}
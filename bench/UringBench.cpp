@@ -0,0 +1,170 @@
+/*
+UringBench.cpp
+
+The MIT License
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+// \brief Compares tNMEA0183Poller (epoll) and tNMEA0183UringReader on socket pair
+// and pseudo terminal sources. Writer thread writes to all sources round robin.
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <sys/socket.h>
+#include <NMEA0183.h>
+#include <NMEA0183Poller.h>
+#include <NMEA0183Uring.h>
+
+static const char *Sentences[]={
+  "$GPRMC,092348.00,A,6035.04228,N,02115.15472,E,0.01,272.61,060815,7.2,E,D*34\r\n",
+  "$GPGGA,182435.00,6023.20859,N,02219.99442,E,2,10,0.9,4.0,M,20.6,M,5.0,0120*4D\r\n",
+  "$IIDPT,10.5,0.9*7D\r\n",
+  "$GPZDA,160012.71,11,03,2004,-1,00*7D\r\n",
+  "!AIVDM,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0*5C\r\n"
+};
+
+//-----------------------------------------------------------------------------
+// Non blocking stream on descriptor for tNMEA0183Poller.
+class tFdStream : public tNMEA0183Stream {
+protected:
+  int fd;
+public:
+  tFdStream(int _fd) : fd(_fd) { fcntl(fd,F_SETFL,O_NONBLOCK); }
+  virtual ~tFdStream() {}
+  int read() { uint8_t c; return ( ::read(fd,&c,1)==1?c:-1 ); }
+  size_t read(uint8_t *buf, size_t max) { ssize_t n=::read(fd,buf,max); return ( n>0?n:0 ); }
+  size_t write(const uint8_t* data, size_t size) { (void)data; return size; }
+  int GetReadFd() const { return fd; }
+};
+
+struct tSourcePair {
+  int ReadFd;
+  int WriteFd;
+};
+
+static bool OpenSocketPair(tSourcePair &Pair) {
+  int fds[2];
+  if ( socketpair(AF_UNIX,SOCK_STREAM,0,fds)!=0 ) return false;
+  Pair.ReadFd=fds[0];
+  Pair.WriteFd=fds[1];
+  return true;
+}
+
+static bool OpenPty(tSourcePair &Pair) {
+  int Master=posix_openpt(O_RDWR | O_NOCTTY);
+  if ( Master==-1 || grantpt(Master)!=0 || unlockpt(Master)!=0 ) return false;
+  struct termios tio;
+  tcgetattr(Master,&tio);
+  cfmakeraw(&tio);
+  tcsetattr(Master,TCSANOW,&tio);
+  Pair.WriteFd=Master;
+  Pair.ReadFd=open(ptsname(Master),O_RDWR | O_NOCTTY);
+  return Pair.ReadFd!=-1;
+}
+
+static size_t MsgCount=0;
+
+static void CountMessage(const tNMEA0183Msg &NMEA0183Msg) {
+  (void)NMEA0183Msg;
+  MsgCount++;
+}
+
+// Write Rounds copies of Data to each pair round robin.
+static void WriteSources(std::vector<tSourcePair> &Pairs, const std::string &Data, size_t Rounds) {
+  for (size_t r=0; r<Rounds; r++) {
+    for (size_t i=0; i<Pairs.size(); i++) {
+      for (size_t pos=0; pos<Data.size(); ) {
+        ssize_t n=::write(Pairs[i].WriteFd,Data.data()+pos,Data.size()-pos);
+        if ( n<=0 ) return;
+        pos+=n;
+      }
+    }
+  }
+}
+
+static void Run(const char *Name, bool (*OpenPair)(tSourcePair &), size_t Sources, bool UseUring, size_t Rounds) {
+  std::vector<tSourcePair> Pairs(Sources);
+  std::vector<tFdStream *> Streams;
+  std::vector<tNMEA0183 *> Ports;
+  tNMEA0183Poller Poller(Sources);
+  tNMEA0183UringReader Reader(Sources,4096);
+  std::string Data;
+
+  if ( UseUring && !Reader.IsOpen() ) {
+    printf("%-32s io_uring not available\n",Name);
+    return;
+  }
+  for (size_t i=0; i<50; i++) Data+=Sentences[i%(sizeof(Sentences)/sizeof(Sentences[0]))];
+  size_t Expected=50*Rounds*Sources;
+
+  for (size_t i=0; i<Sources; i++) {
+    if ( !OpenPair(Pairs[i]) ) {
+      printf("%-32s could not open sources\n",Name);
+      return;
+    }
+    Streams.push_back(new tFdStream(Pairs[i].ReadFd));
+    Ports.push_back(new tNMEA0183(Streams.back(),i));
+    Ports.back()->SetMsgHandler(CountMessage);
+    if ( UseUring ) Reader.Add(Pairs[i].ReadFd,Ports.back()); else Poller.Add(Ports.back());
+  }
+
+  MsgCount=0;
+  auto start=std::chrono::steady_clock::now();
+  std::thread Writer(WriteSources,std::ref(Pairs),std::cref(Data),Rounds);
+  while ( MsgCount<Expected ) {
+    size_t n=( UseUring?Reader.Poll(1000):Poller.Poll(1000) );
+    if ( n==0 && std::chrono::steady_clock::now()-start>std::chrono::seconds(30) ) break;
+  }
+  std::chrono::duration<double> secs=std::chrono::steady_clock::now()-start;
+  Writer.join();
+  printf("%-32s %10.0f sentences/s%s\n",Name,MsgCount/secs.count(),(MsgCount<Expected?" (incomplete)":""));
+
+  if ( UseUring ) {
+    for (size_t i=0; i<Sources; i++) Reader.Remove(Ports[i]);
+    for (int i=0; i<10 && Reader.SourceCount()>0; i++) Reader.Poll(10);
+  }
+  for (size_t i=0; i<Sources; i++) {
+    if ( !UseUring ) Poller.Remove(Ports[i]);
+    delete Ports[i];
+    delete Streams[i];
+    close(Pairs[i].ReadFd);
+    close(Pairs[i].WriteFd);
+  }
+}
+
+int main(int argc, char **argv) {
+  size_t Rounds=(argc>1?atoi(argv[1]):2000);
+  size_t Sources=(argc>2?atoi(argv[2]):16);
+
+  Run("epoll (socket pair)",OpenSocketPair,Sources,false,Rounds);
+  Run("io_uring (socket pair)",OpenSocketPair,Sources,true,Rounds);
+  Run("epoll (pty)",OpenPty,Sources,false,Rounds/4);
+  Run("io_uring (pty)",OpenPty,Sources,true,Rounds/4);
+
+  return 0;
+}
@@ -0,0 +1,159 @@
+/*
+CoroutineTest.cpp
+
+The MIT License
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+// \brief Tests for coroutine interface. Built with C++20.
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <catch2/catch.hpp>
+#include <NMEA0183Coroutine.h>
+#include <NMEA0183Messages.h>
+
+#ifdef __cpp_impl_coroutine
+
+// Collects route waypoint names from multi sentence RTE like route assembly would.
+static tNMEA0183Task CollectRoute(tNMEA0183CoSource &Source, std::vector<std::string> &Route, bool &Done) {
+  for (;;) {
+    const tNMEA0183MsgBase *Msg=co_await Source.NextMessage("RTE");
+    for (uint8_t i=4; i<Msg->FieldCount(); i++) Route.push_back(Msg->Field(i));
+    if ( atoi(Msg->Field(0))==atoi(Msg->Field(1)) ) break; // Last sentence
+  }
+  Done=true;
+}
+
+static tNMEA0183Task WatchDepth(tNMEA0183CoSource &Source, int &Depths, int &Timeouts) {
+  for (;;) {
+    const tNMEA0183MsgBase *Msg=co_await Source.NextMessage("DPT",20);
+    if ( Msg==0 ) {
+      Timeouts++;
+      co_return;
+    }
+    Depths++;
+  }
+}
+
+TEST_CASE("Coroutines wait messages")
+{
+  const char *Data=
+    "$GPRTE,2,1,c,0,W1,W2*07\r\n"
+    "$IIDPT,10.5,0.9*7D\r\n"
+    "$GPZDA,160012.71,11,03,2004,-1,00*7D\r\n"
+    "$GPRTE,2,2,c,0,W3*4F\r\n"
+    "$IIDPT,10.5,0.9*7D\r\n";
+  tNMEA0183 NMEA0183;
+  tNMEA0183CoSource Source;
+  tNMEA0183CoLoop Loop;
+  std::vector<std::string> Route;
+  bool RouteDone=false;
+  int Depths=0, Timeouts=0;
+
+  NMEA0183.SetDefaultMsgHandler(tNMEA0183CoSource::MsgHandler,&Source);
+  Loop.AddSource(&Source);
+  CollectRoute(Source,Route,RouteDone);
+  WatchDepth(Source,Depths,Timeouts);
+  CHECK(Loop.HasWaiters());
+
+  CHECK(NMEA0183.Feed(Data,strlen(Data))==5);
+  CHECK(RouteDone);
+  REQUIRE(Route.size()==3);
+  CHECK(Route[2]=="W3");
+  CHECK(Depths==2);
+  CHECK(Timeouts==0);
+
+  // Depth watcher times out, since no more data comes.
+  Loop.Run();
+  CHECK(Timeouts==1);
+  CHECK_FALSE(Loop.HasWaiters());
+}
+
+static tNMEA0183Task Ticker(tNMEA0183CoLoop &Loop, int &Ticks) {
+  for (int i=0; i<3; i++) {
+    co_await Loop.Sleep(1);
+    Ticks++;
+  }
+}
+
+TEST_CASE("Coroutine sleep")
+{
+  tNMEA0183CoLoop Loop;
+  int Ticks=0;
+
+  Ticker(Loop,Ticks);
+  CHECK(Ticks==0);
+  Loop.Run();
+  CHECK(Ticks==3);
+}
+
+// Non blocking stream on one end of socket pair, which counts read calls.
+class tCountingSocketStream : public tNMEA0183Stream {
+public:
+  int fds[2];
+  size_t Reads;
+  tCountingSocketStream() : Reads(0) {
+    if ( socketpair(AF_UNIX,SOCK_STREAM,0,fds)==0 ) fcntl(fds[0],F_SETFL,O_NONBLOCK);
+  }
+  ~tCountingSocketStream() { close(fds[0]); close(fds[1]); }
+  int read() { uint8_t c; return ( read(&c,1)==1?c:-1 ); }
+  size_t read(uint8_t *buf, size_t max) { Reads++; ssize_t n=::read(fds[0],buf,max); return ( n>0?n:0 ); }
+  size_t write(const uint8_t* data, size_t size) { ssize_t n=::write(fds[0],data,size); return ( n>0?n:0 ); }
+  int GetReadFd() const { return fds[0]; }
+  int GetWriteFd() const { return fds[0]; }
+};
+
+static tNMEA0183Task WaitDepth(tNMEA0183CoSource &Source, bool &Received) {
+  Received=( co_await Source.NextMessage("DPT",2000) )!=0;
+}
+
+TEST_CASE("Coroutine loop sleeps until data")
+{
+  tCountingSocketStream Stream;
+  tNMEA0183 NMEA0183(&Stream);
+  REQUIRE(NMEA0183.Open());
+  tNMEA0183CoSource Source(&NMEA0183);
+  tNMEA0183CoLoop Loop;
+  bool Received=false;
+
+  Loop.AddSource(&Source);
+  WaitDepth(Source,Received);
+  ssize_t Written=0;
+  std::thread Writer([&Stream,&Written]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    Written=::write(Stream.fds[1],"$IIDPT,10.5,0.9*7D\r\n",20);
+  });
+  Loop.Run();
+  Writer.join();
+  CHECK(Written==20);
+  CHECK(Received);
+  // Stream is read only, when it has data, instead of every IdleMs.
+  CHECK(Stream.Reads<10);
+}
+
+#endif
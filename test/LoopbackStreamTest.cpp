@@ -0,0 +1,141 @@
+/*
+LoopbackStreamTest.cpp
+
+The MIT License
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+// \brief Tests for tNMEA0183MemoryStream and tNMEA0183PtyStream.
+
+#include <string>
+#include <vector>
+
+#include <string.h>
+#include <catch2/catch.hpp>
+#include <NMEA0183.h>
+#include <NMEA0183MemoryStream.h>
+#include <NMEA0183PtyStream.h>
+#include <NMEA0183SerialStream.h>
+
+static const char *LoopbackSentences[]={
+  "$GPRMC,092348.00,A,6035.04228,N,02115.15472,E,0.01,272.61,060815,7.2,E,D*34",
+  "$GPGGA,182435.00,6023.20859,N,02219.99442,E,2,10,0.9,4.0,M,20.6,M,5.0,0120*4D",
+  "$IIDPT,10.5,0.9*7D",
+  "$GPZDA,160012.71,11,03,2004,-1,00*7D",
+  "!AIVDM,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0*5C"
+};
+static const size_t LoopbackSentenceCount=sizeof(LoopbackSentences)/sizeof(LoopbackSentences[0]);
+
+static std::vector<std::string> LoopbackMessages;
+
+static void CollectLoopbackMessage(const tNMEA0183Msg &NMEA0183Msg) {
+  char buf[100];
+  if ( NMEA0183Msg.GetMessage(buf,sizeof(buf)) ) LoopbackMessages.push_back(buf);
+}
+
+// Send Count sentences with Sender and parse them with Receiver. Receiver is
+// polled, whenever sender can not buffer more.
+static void SendSentences(tNMEA0183 &Sender, tNMEA0183 &Receiver, size_t Count, bool Wait) {
+  tNMEA0183Msg Msg;
+  for (size_t i=0; i<Count; i++) {
+    REQUIRE(Msg.SetMessage(LoopbackSentences[i%LoopbackSentenceCount]));
+    for (int Tries=0; !Sender.SendMessage(Msg); Tries++) {
+      REQUIRE(Tries<1000);
+      if ( Wait ) Receiver.ParseMessages(10); else Receiver.ParseMessages();
+    }
+  }
+  for (int Tries=0; LoopbackMessages.size()<Count && Tries<1000; Tries++) {
+    Sender.OnWritable();
+    if ( Wait ) Receiver.ParseMessages(10); else Receiver.ParseMessages();
+  }
+}
+
+static void CheckSentences(size_t Count) {
+  REQUIRE(LoopbackMessages.size()==Count);
+  for (size_t i=0; i<Count; i++) {
+    CHECK(LoopbackMessages[i]==LoopbackSentences[i%LoopbackSentenceCount]);
+  }
+}
+
+TEST_CASE("Memory stream ring")
+{
+  tNMEA0183MemoryStream Stream(10);  // Rounded to 16
+  uint8_t buf[32];
+
+  CHECK(Stream.available()==0);
+  CHECK(Stream.availableForWrite()==16);
+  CHECK(Stream.read()==-1);
+  CHECK(Stream.read(buf,sizeof(buf))==0);
+
+  // Full ring accepts only part of data.
+  CHECK(Stream.write((const uint8_t *)"0123456789ABCDEFGH",18)==16);
+  CHECK(Stream.availableForWrite()==0);
+  CHECK(Stream.write((const uint8_t *)"X",1)==0);
+  CHECK(Stream.read()=='0');
+  CHECK(Stream.read(buf,9)==9);
+  CHECK(std::string((char *)buf,9)=="123456789");
+
+  // Data wrapping around end of ring is read with one call.
+  CHECK(Stream.write((const uint8_t *)"GHIJKLMN",8)==8);
+  CHECK(Stream.available()==14);
+  CHECK(Stream.read(buf,sizeof(buf))==14);
+  CHECK(std::string((char *)buf,14)=="ABCDEFGHIJKLMN");
+  CHECK(Stream.available()==0);
+}
+
+TEST_CASE("Memory stream loopback")
+{
+  // Ring smaller than sent data, so sending has to wait for receiver.
+  tNMEA0183MemoryStream Stream(256);
+  tNMEA0183 NMEA0183(&Stream);
+  NMEA0183.SetMsgHandler(CollectLoopbackMessage);
+  REQUIRE(NMEA0183.Open());
+
+  LoopbackMessages.clear();
+  SendSentences(NMEA0183,NMEA0183,1000,false);
+  CheckSentences(1000);
+  CHECK_FALSE(NMEA0183.HasPendingOutput());
+}
+
+TEST_CASE("Pty stream pair")
+{
+  tNMEA0183PtyStream Pty;
+  REQUIRE(Pty.IsOpen());
+  CHECK(strncmp(Pty.GetPeerName(),"/dev/pts/",9)==0);
+  tNMEA0183SerialStream Peer(Pty.GetPeerName(),115200);
+  REQUIRE(Peer.IsOpen());
+
+  tNMEA0183 PtyNMEA0183(&Pty);
+  tNMEA0183 PeerNMEA0183(&Peer);
+  PtyNMEA0183.SetMsgHandler(CollectLoopbackMessage);
+  PeerNMEA0183.SetMsgHandler(CollectLoopbackMessage);
+  REQUIRE(PtyNMEA0183.Open());
+  REQUIRE(PeerNMEA0183.Open());
+
+  // More than pty buffers, so both ends have to handle short writes.
+  LoopbackMessages.clear();
+  SendSentences(PtyNMEA0183,PeerNMEA0183,2000,true);
+  CheckSentences(2000);
+
+  LoopbackMessages.clear();
+  SendSentences(PeerNMEA0183,PtyNMEA0183,2000,true);
+  CheckSentences(2000);
+}
@@ -73,3 +73,51 @@ TEST_CASE("ZDA")
     CHECK(NMEA0183SetZDA(dst, GPSTime, GPSDay, GPSMonth, GPSYear, LZD, LZMD));
   });
 }
+
+TEST_CASE("Field lengths")
+{
+  const char buf[]="$IIDPT,10.5,,100*47XX";
+  tNMEA0183Msg Msg;
+
+  REQUIRE(Msg.SetMessage(buf,strlen(buf)-2));
+  REQUIRE(Msg.FieldCount()==3);
+  CHECK(Msg.FieldLen(0)==4);
+  CHECK(Msg.FieldLen(1)==0);
+  CHECK(Msg.FieldLen(2)==3);
+  CHECK(Msg.FieldLen(3)==0);
+  CHECK(Msg.FieldView(0).Equals("10.5"));
+  CHECK(Msg.FieldView(1).IsEmpty());
+  CHECK_FALSE(Msg.SetMessage(buf,strlen(buf)-4));
+
+  tNMEA0183Msg Built;
+  REQUIRE(Built.Init("DPT"));
+  REQUIRE(Built.AddDoubleField(10.5));
+  REQUIRE(Built.AddEmptyField());
+  REQUIRE(Built.AddStrField("100"));
+  CHECK(Built.FieldLen(0)==4);
+  CHECK(Built.FieldLen(1)==0);
+  CHECK(Built.FieldLen(2)==3);
+}
+
+TEST_CASE("Packed message code")
+{
+  tNMEA0183Msg Msg;
+
+  REQUIRE(Msg.SetMessage("$GPZDA,160012.71,11,03,2004,-1,00*7D"));
+  CHECK(Msg.MessageCodeKey()==NMEA0183Code("ZDA"));
+  CHECK(Msg.SenderKey()==NMEA0183Sender("GP"));
+  CHECK(Msg.IsMessageCode(NMEA0183Code("ZDA")));
+  CHECK_FALSE(Msg.IsMessageCode(NMEA0183Code("ZD")));
+  CHECK(NMEA0183Code("RMC")==0x524d43);
+  CHECK(NMEA0183Code("LONGCODE9")==NMEA0183CodeNA);
+
+  switch ( Msg.MessageCodeKey() ) {
+    case NMEA0183Code("RMC"): FAIL(); break;
+    case NMEA0183Code("ZDA"): SUCCEED(); break;
+    default: FAIL();
+  }
+
+  REQUIRE(Msg.Init("RF103","PS"));
+  CHECK(Msg.MessageCodeKey()==NMEA0183Code("RF103"));
+  CHECK(Msg.SenderKey()==NMEA0183Sender("PS"));
+}
@@ -0,0 +1,96 @@
+/*
+MsgViewTest.cpp
+
+The MIT License
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+// \brief Tests for tNMEA0183MsgView.
+
+#include <string.h>
+#include <catch2/catch.hpp>
+#include <NMEA0183Messages.h>
+
+TEST_CASE("View fields")
+{
+  // Buffer is not null terminated after message
+  const char buf[]="$GPRMB,A,0.15,R,WOUBRG,WETERB,5213.400,N,00438.400,E,009.4,180.2,,V*07\r\n$GP";
+  tNMEA0183MsgView View;
+
+  CHECK_FALSE(View.SetMessage(buf,10));
+  REQUIRE(View.SetMessage(buf,sizeof(buf)-1));
+  CHECK(View.GetPrefix()=='$');
+  CHECK_THAT(View.Sender(),Catch::Matchers::Equals("GP"));
+  CHECK(View.IsMessageCode("RMB"));
+  CHECK(View.FieldCount()==13);
+  CHECK(View.FieldLen(3)==6);
+  CHECK(strncmp(View.Field(3),"WOUBRG",6)==0);
+  CHECK(View.FieldLen(11)==0);
+  CHECK(View.Field(11)[0]==0);
+  CHECK(View.FieldLen(12)==1);
+  CHECK(View.Field(20)[0]==0);
+}
+
+TEST_CASE("View invalid checksum")
+{
+  tNMEA0183MsgView View;
+
+  CHECK_FALSE(View.SetMessage("$IIDPT,10.5,0.9*7E"));
+  CHECK_FALSE(View.SetMessage("$IIDPT*7D"));
+  CHECK_FALSE(View.SetMessage("$IIDPT,10.5,0.9*7"));
+  CHECK(View.SetMessage("$IIDPT,10.5,0.9*7d"));
+}
+
+TEST_CASE("Parse RMB with view and message")
+{
+  const char *buf="$GPRMB,A,0.15,R,WOUBRG,WETERB,5213.400,N,00438.400,E,009.4,180.2,,V*07";
+  tNMEA0183MsgView View;
+  tNMEA0183Msg Msg;
+  tRMB ViewRMB, MsgRMB;
+
+  REQUIRE(View.SetMessage(buf));
+  REQUIRE(Msg.SetMessage(buf));
+  REQUIRE(NMEA0183ParseRMB(View,ViewRMB));
+  REQUIRE(NMEA0183ParseRMB(Msg,MsgRMB));
+  CHECK_THAT(ViewRMB.originID,Catch::Matchers::Equals("WOUBRG"));
+  CHECK_THAT(ViewRMB.destID,Catch::Matchers::Equals("WETERB"));
+  CHECK(ViewRMB.status==MsgRMB.status);
+  CHECK(ViewRMB.xte==MsgRMB.xte);
+  CHECK(ViewRMB.latitude==MsgRMB.latitude);
+  CHECK(ViewRMB.longitude==MsgRMB.longitude);
+  CHECK(ViewRMB.arrivalAlarm=='V');
+}
+
+TEST_CASE("Parse RMC with view")
+{
+  const char *buf="$GPRMC,092348.00,A,6035.04228,N,02115.15472,E,0.01,272.61,060815,7.2,E,D*34";
+  tNMEA0183MsgView View;
+  tNMEA0183Msg Msg;
+  tRMC ViewRMC, MsgRMC;
+
+  REQUIRE(View.SetMessage(buf));
+  REQUIRE(Msg.SetMessage(buf));
+  REQUIRE(NMEA0183ParseRMC(View,ViewRMC));
+  REQUIRE(NMEA0183ParseRMC(Msg,MsgRMC));
+  CHECK(ViewRMC.status=='A');
+  CHECK(ViewRMC.daysSince1970==MsgRMC.daysSince1970);
+  CHECK(ViewRMC.daysSince1970!=NMEA0183UInt32NA);
+  CHECK(ViewRMC.variation==MsgRMC.variation);
+}
@@ -0,0 +1,380 @@
+/*
+NMEA0183Test.cpp
+
+The MIT License
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+// \brief Tests for message framing in tNMEA0183.
+
+#include <string>
+#include <vector>
+
+#include <string.h>
+#include <catch2/catch.hpp>
+#include <NMEA0183.h>
+#include <NMEA0183Scan.h>
+#include <NMEA0183Messages.h>
+
+static std::vector<std::string> ReceivedMessages;
+
+static void CollectMessage(const tNMEA0183Msg &NMEA0183Msg) {
+  char buf[100];
+  if ( NMEA0183Msg.GetMessage(buf,sizeof(buf)) ) ReceivedMessages.push_back(buf);
+}
+
+// Framing used from static constructor, which may run before initializers of library.
+static size_t StaticInitMsgCount=tNMEA0183().Feed("$IIDPT,10.5,0.9*7D\r\n",20,CollectMessage);
+
+static const char *TestFeed=
+  "garbage\r\n"
+  "$IIDPT,10.5,0.9*7D\r\n"
+  "$GPZDA,160012.71,11,03,2004,-1,00*7D\r\n"
+  "$IIDPT,10.5,0.9*00\r\n"                  // Invalid checksum
+  "!AIVDM,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0*5C\r\n";
+
+TEST_CASE("Feed on static initialization")
+{
+  CHECK(StaticInitMsgCount==1);
+}
+
+TEST_CASE("Feed whole buffer")
+{
+  tNMEA0183 NMEA0183;
+
+  ReceivedMessages.clear();
+  CHECK(NMEA0183.Feed(TestFeed,strlen(TestFeed),CollectMessage)==3);
+  REQUIRE(ReceivedMessages.size()==3);
+  CHECK(ReceivedMessages[0]=="$IIDPT,10.5,0.9*7D");
+  CHECK(ReceivedMessages[1]=="$GPZDA,160012.71,11,03,2004,-1,00*7D");
+  CHECK(ReceivedMessages[2]=="!AIVDM,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0*5C");
+}
+
+TEST_CASE("Feed split buffer")
+{
+  tNMEA0183 NMEA0183;
+  size_t len=strlen(TestFeed);
+  size_t MsgCount=0;
+
+  ReceivedMessages.clear();
+  NMEA0183.SetMsgHandler(CollectMessage);
+  for (size_t i=0; i<len; i+=7) {
+    MsgCount+=NMEA0183.Feed(TestFeed+i,(len-i<7?len-i:7));
+  }
+  CHECK(MsgCount==3);
+  CHECK(ReceivedMessages.size()==3);
+}
+
+//-----------------------------------------------------------------------------
+// Stream returning data in small blocks.
+class tTestBlockStream : public tNMEA0183Stream {
+protected:
+  const char *Data;
+  size_t Len;
+  size_t Pos;
+public:
+  size_t BlockReads;
+  tTestBlockStream(const char *_Data) : Data(_Data), Len(strlen(_Data)), Pos(0), BlockReads(0) {}
+  int read() { return ( Pos<Len?(uint8_t)Data[Pos++]:-1 ); }
+  size_t read(uint8_t *buf, size_t max) {
+    if ( max>Len-Pos ) max=Len-Pos;
+    if ( max>5 ) max=5;
+    memcpy(buf,Data+Pos,max);
+    Pos+=max;
+    if ( max>0 ) BlockReads++;
+    return max;
+  }
+  size_t write(const uint8_t* data, size_t size) { (void)data; return size; }
+};
+
+TEST_CASE("ParseMessages with block read")
+{
+  tTestBlockStream Stream(TestFeed);
+  tNMEA0183 NMEA0183(&Stream);
+
+  ReceivedMessages.clear();
+  NMEA0183.SetMsgHandler(CollectMessage);
+  NMEA0183.ParseMessages();
+  CHECK(ReceivedMessages.size()==3);
+  CHECK(Stream.BlockReads==(strlen(TestFeed)+4)/5);
+}
+
+TEST_CASE("Delimiter scan")
+{
+  char buf[200];
+
+  for (size_t i=0; i<sizeof(buf); i++) buf[i]='a'+i%26;
+  for (size_t len=0; len<=sizeof(buf); len+=7) {
+    for (size_t pos=0; pos<len; pos+=3) {
+      char old=buf[pos];
+      buf[pos]='*';
+      CHECK(NMEA0183FindMsgStart(buf,buf+len)==buf+len);
+      CHECK(NMEA0183FindMsgDelimiter(buf,buf+len)==buf+pos);
+      buf[pos]='!';
+      CHECK(NMEA0183FindMsgStart(buf,buf+len)==buf+pos);
+      buf[pos]=old;
+    }
+  }
+}
+
+TEST_CASE("Feed noisy and too long data")
+{
+  std::string Data;
+  tNMEA0183 NMEA0183;
+
+  for (int i=0; i<100; i++) Data+="noise*";
+  Data+="$IIDPT,";
+  for (int i=0; i<100; i++) Data+="0";  // Too long message
+  Data+="*00";
+  Data+=TestFeed;
+  Data+="$IIDPT,10.5*$IIDPT,10.5,0.9*7D"; // Restart before checksum
+
+  ReceivedMessages.clear();
+  CHECK(NMEA0183.Feed(Data.c_str(),Data.size(),CollectMessage)==4);
+  REQUIRE(ReceivedMessages.size()==4);
+  CHECK(ReceivedMessages[3]=="$IIDPT,10.5,0.9*7D");
+}
+
+TEST_CASE("Subscriptions")
+{
+  tNMEA0183 NMEA0183;
+
+  CHECK(NMEA0183.Subscribe("ZDA","GP"));
+  CHECK(NMEA0183.Subscribe("VD?","AI"));
+  CHECK_FALSE(NMEA0183.Subscribe("TOOLONGCODE1"));
+  CHECK(NMEA0183.IsSubscribed("GP","ZDA"));
+  CHECK_FALSE(NMEA0183.IsSubscribed("II","ZDA"));
+  CHECK(NMEA0183.IsSubscribed("AI","VDO"));
+
+  ReceivedMessages.clear();
+  CHECK(NMEA0183.Feed(TestFeed,strlen(TestFeed),CollectMessage)==2);
+  REQUIRE(ReceivedMessages.size()==2);
+  CHECK(ReceivedMessages[0]=="$GPZDA,160012.71,11,03,2004,-1,00*7D");
+  CHECK(ReceivedMessages[1]=="!AIVDM,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0*5C");
+  CHECK(NMEA0183.GetStats().Received==2);
+  CHECK(NMEA0183.GetStats().Filtered==2);
+  CHECK(NMEA0183.GetStats().Errors==0);
+
+  // Byte by byte feeding goes through same states.
+  ReceivedMessages.clear();
+  for (const char *p=TestFeed; *p!=0; p++) NMEA0183.Feed(p,1,CollectMessage);
+  CHECK(ReceivedMessages.size()==2);
+  CHECK(NMEA0183.GetStats().Filtered==4);
+
+  NMEA0183.ClearSubscriptions();
+  NMEA0183.ResetStats();
+  ReceivedMessages.clear();
+  CHECK(NMEA0183.Feed(TestFeed,strlen(TestFeed),CollectMessage)==3);
+  CHECK(NMEA0183.GetStats().Errors==1);
+  CHECK(NMEA0183.GetStats().Filtered==0);
+}
+
+static void CollectWithContext(const tNMEA0183MsgBase &NMEA0183Msg, void *Context) {
+  char buf[100];
+  if ( NMEA0183Msg.GetMessage(buf,sizeof(buf)) ) ((std::vector<std::string> *)Context)->push_back(buf);
+}
+
+TEST_CASE("Message handlers")
+{
+  tNMEA0183 NMEA0183;
+  std::vector<std::string> DPT, GPZDA, Other;
+
+  CHECK(NMEA0183.AddMsgHandler("DPT",CollectWithContext,&DPT));
+  CHECK(NMEA0183.AddMsgHandler("ZDA",CollectWithContext,&GPZDA,"GP"));
+  CHECK(NMEA0183.AddMsgHandler("ZDA",CollectWithContext,&Other));
+  CHECK_FALSE(NMEA0183.AddMsgHandler("DPT",0));
+  NMEA0183.SetDefaultMsgHandler(CollectWithContext,&Other);
+
+  std::string Data=TestFeed;
+  Data+="$IIZDA,160012.71,11,03,2004,-1,00*6A\r\n";
+  NMEA0183.Feed(Data.c_str(),Data.size());
+  REQUIRE(DPT.size()==1);
+  CHECK(DPT[0]=="$IIDPT,10.5,0.9*7D");
+  REQUIRE(GPZDA.size()==1);
+  REQUIRE(Other.size()==2);
+  CHECK(Other[0]=="!AIVDM,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0*5C");
+  CHECK(Other[1]=="$IIZDA,160012.71,11,03,2004,-1,00*6A");
+
+  for (int i=0; i<MAX_NMEA0183_MSG_HANDLERS*2; i++) {
+    char Code[8];
+    sprintf(Code,"X%02d",i);
+    if ( !NMEA0183.AddMsgHandler(Code,CollectWithContext,&Other) ) break;
+  }
+  DPT.clear();
+  NMEA0183.Feed(TestFeed,strlen(TestFeed));
+  CHECK(DPT.size()==1);
+}
+
+TEST_CASE("Sender filtered message handler")
+{
+  tNMEA0183 NMEA0183;
+  std::vector<std::string> GPZDA, Other;
+  tNMEA0183Msg Msg;
+
+  CHECK(NMEA0183.AddMsgHandler("ZDA",CollectWithContext,&GPZDA,"GP"));
+  NMEA0183.SetDefaultMsgHandler(CollectWithContext,&Other);
+
+  // Message from other sender goes to default handler.
+  const char *ZDA="$IIZDA,160012.71,11,03,2004,-1,00*6A\r\n";
+  NMEA0183.Feed(ZDA,strlen(ZDA));
+  CHECK(GPZDA.empty());
+  REQUIRE(Other.size()==1);
+  CHECK(Other[0]=="$IIZDA,160012.71,11,03,2004,-1,00*6A");
+
+  tNMEA0183Dispatcher Dispatcher;
+  CHECK(Dispatcher.AddHandler("ZDA",CollectWithContext,&GPZDA,"GP"));
+  REQUIRE(Msg.SetMessage("$IIZDA,160012.71,11,03,2004,-1,00*6A"));
+  CHECK_FALSE(Dispatcher.Dispatch(Msg));
+  REQUIRE(Msg.SetMessage("$GPZDA,160012.71,11,03,2004,-1,00*7D"));
+  CHECK(Dispatcher.Dispatch(Msg));
+  CHECK(GPZDA.size()==1);
+}
+
+static size_t LongMsgFieldCount=0;
+
+static void CountLongMsgFields(const tNMEA0183MsgT<160,40> &NMEA0183Msg) {
+  LongMsgFieldCount=NMEA0183Msg.FieldCount();
+}
+
+TEST_CASE("Message capacity")
+{
+  std::string Data="$PXLNG";
+  for (int i=0; i<30; i++) Data+=",1234";
+  uint8_t cs=0;
+  for (size_t i=1; i<Data.size(); i++) cs^=Data[i];
+  char csStr[8];
+  sprintf(csStr,"*%02X\r\n",cs);
+  Data+=csStr;
+
+  tNMEA0183 NMEA0183;
+  CHECK(NMEA0183.Feed(Data.c_str(),Data.size())==0); // Too long for default capacity
+
+  tNMEA0183T<160,40> LongNMEA0183;
+  LongMsgFieldCount=0;
+  CHECK(LongNMEA0183.Feed(Data.c_str(),Data.size(),CountLongMsgFields)==1);
+  CHECK(LongMsgFieldCount==30);
+
+  tNMEA0183MsgT<160,40> LongMsg;
+  tNMEA0183Msg Msg;
+  REQUIRE(LongMsg.SetMessage(Data.c_str()));
+  CHECK_FALSE(Msg.CopyFrom(LongMsg));
+  REQUIRE(Msg.SetMessage("$IIDPT,10.5,0.9*7D"));
+  LongMsg=Msg;
+  double Depth, Offset;
+  CHECK(NMEA0183ParseDPT(LongMsg,Depth,Offset));
+  CHECK(Depth==10.5);
+
+  tNMEA0183MsgT<32,4> ShortMsg;
+  CHECK_FALSE(ShortMsg.SetMessage("$GPZDA,160012.71,11,03,2004,-1,00*7D"));
+}
+
+static std::vector<tNMEA0183TagBlock> ReceivedTagBlocks;
+
+static void CollectTagBlock(const tNMEA0183Msg &NMEA0183Msg) {
+  ReceivedTagBlocks.push_back(NMEA0183Msg.TagBlock());
+}
+
+TEST_CASE("TAG blocks")
+{
+  const char *Data=
+    "\\s:r003669945,c:1241544035*79\\!AIVDM,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0*5C\r\n"
+    "$IIDPT,10.5,0.9*7D\r\n"
+    "\\g:1-2-73874,n:157036,s:r003669945,c:1241544035123*7A\\$IIDPT,10.5,0.9*7D\r\n"
+    "\\s:r003669945,c:1241544035*00\\$IIDPT,10.5,0.9*7D\r\n";  // Invalid TAG block checksum
+  tNMEA0183 NMEA0183;
+
+  ReceivedTagBlocks.clear();
+  CHECK(NMEA0183.Feed(Data,strlen(Data),CollectTagBlock)==4);
+  REQUIRE(ReceivedTagBlocks.size()==4);
+  CHECK(ReceivedTagBlocks[0].Flags==(tNMEA0183TagBlock::tbSource | tNMEA0183TagBlock::tbUnixTime));
+  CHECK(strcmp(ReceivedTagBlocks[0].Source,"r003669945")==0);
+  CHECK(ReceivedTagBlocks[0].UnixTime==1241544035);
+  CHECK(ReceivedTagBlocks[1].Flags==0);
+  CHECK(ReceivedTagBlocks[2].Has(tNMEA0183TagBlock::tbGroup));
+  CHECK(ReceivedTagBlocks[2].GroupSentence==1);
+  CHECK(ReceivedTagBlocks[2].GroupSentences==2);
+  CHECK(ReceivedTagBlocks[2].GroupId==73874);
+  CHECK(ReceivedTagBlocks[2].LineCount==157036);
+  CHECK(ReceivedTagBlocks[2].UnixTime==1241544035);
+  CHECK(ReceivedTagBlocks[2].UnixTimeMs==123);
+  CHECK(ReceivedTagBlocks[3].Flags==0);
+  CHECK(NMEA0183.GetStats().Errors==1);
+
+  tNMEA0183Msg Msg;
+  REQUIRE(Msg.SetMessage("\\s:r003669945,c:1241544035*79\\$IIDPT,10.5,0.9*7D"));
+  CHECK(Msg.TagBlock().UnixTime==1241544035);
+  CHECK(Msg.IsMessageCode("DPT"));
+  CHECK_FALSE(Msg.SetMessage("\\s:r003669945,c:1241544035*00\\$IIDPT,10.5,0.9*7D"));
+}
+
+TEST_CASE("TAG block without sentence")
+{
+  tNMEA0183 NMEA0183;
+  // TAG block alone or followed by garbage on its line is not given to next sentence.
+  const char *Data=
+    "\\s:r003669945,c:1241544035*79\\\r\n"
+    "$IIDPT,10.5,0.9*7D\r\n"
+    "\\s:r003669945,c:1241544035*79\\garbage\r\n"
+    "$IIDPT,10.5,0.9*7D\r\n"
+    "\\s:r003669945,c:1241544035*79\\$IIDPT,10.5,0.9*7D\r\n";
+
+  ReceivedTagBlocks.clear();
+  // Line end in other block than TAG block
+  CHECK(NMEA0183.Feed(Data,30,CollectTagBlock)==0);
+  CHECK(NMEA0183.Feed(Data+30,strlen(Data)-30,CollectTagBlock)==3);
+  REQUIRE(ReceivedTagBlocks.size()==3);
+  CHECK(ReceivedTagBlocks[0].Flags==0);
+  CHECK(ReceivedTagBlocks[1].Flags==0);
+  CHECK(ReceivedTagBlocks[2].UnixTime==1241544035);
+}
+
+static std::vector<size_t> BatchSizes;
+
+static void CollectBatch(const tNMEA0183Msg *NMEA0183Msgs, size_t Count) {
+  BatchSizes.push_back(Count);
+  for (size_t i=0; i<Count; i++) CollectMessage(NMEA0183Msgs[i]);
+}
+
+TEST_CASE("Batch delivery")
+{
+  tNMEA0183 NMEA0183;
+  std::string Data;
+
+  for (int i=0; i<5; i++) Data+=TestFeed;
+  NMEA0183.SetMsgBatchHandler(CollectBatch,4);
+
+  ReceivedMessages.clear();
+  BatchSizes.clear();
+  // Split inside message, so that incomplete message must continue after batch.
+  size_t Split=Data.size()-20;
+  CHECK(NMEA0183.Feed(Data.c_str(),Split)==14);
+  CHECK(NMEA0183.Feed(Data.c_str()+Split,Data.size()-Split)==1);
+  REQUIRE(BatchSizes.size()==5);
+  CHECK(BatchSizes[0]==4);
+  CHECK(BatchSizes[3]==2);
+  CHECK(BatchSizes[4]==1);
+  REQUIRE(ReceivedMessages.size()==15);
+  CHECK(ReceivedMessages[14]=="!AIVDM,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0*5C");
+
+  NMEA0183.SetMsgBatchHandler(0);
+  BatchSizes.clear();
+  CHECK(NMEA0183.Feed(TestFeed,strlen(TestFeed))==3);
+  CHECK(BatchSizes.size()==0);
+}
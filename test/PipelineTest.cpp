@@ -0,0 +1,106 @@
+/*
+PipelineTest.cpp
+
+The MIT License
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+// \brief Tests for tNMEA0183Pipeline.
+
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <NMEA0183Pipeline.h>
+#include <NMEA0183Messages.h>
+
+static std::string DPTSentence(double Depth) {
+  tNMEA0183Msg Msg;
+  char buf[MAX_NMEA0183_MSG_LEN+1];
+
+  NMEA0183SetDPT(Msg,Depth,0,"SD","%.0f");
+  Msg.GetMessage(buf,sizeof(buf));
+  return std::string(buf)+"\r\n";
+}
+
+struct tDepth {
+  double Depth;
+  double Offset;
+};
+
+TEST_CASE("Pipeline delivers in feed order")
+{
+  const size_t Sources=3;
+  const size_t Messages=3000;
+  std::vector<double> Next(Sources,0);
+  size_t Delivered=0;
+  bool InOrder=true;
+
+  tNMEA0183Pipeline<tDepth> Pipeline(
+    [](const tNMEA0183Msg &Msg, tDepth &Result) { return NMEA0183ParseDPT(Msg,Result.Depth,Result.Offset); },
+    [&](const tNMEA0183Msg &Msg, const tDepth &Result, bool Decoded) {
+      if ( !Decoded || Msg.SourceID>=Sources || Result.Depth!=Next[Msg.SourceID] ) InOrder=false;
+      else Next[Msg.SourceID]++;
+      Delivered++;
+    },
+    4,16);
+
+  // Feed sources interleaved and split sentences to pieces.
+  std::string Pending[Sources];
+  for (size_t i=0; i<Messages; i++) {
+    for (uint8_t s=0; s<Sources; s++) {
+      Pending[s]+=DPTSentence(i);
+      size_t Part=Pending[s].size()/2+s;
+      Pipeline.Feed(s,Pending[s].data(),Part);
+      Pending[s].erase(0,Part);
+    }
+  }
+  for (uint8_t s=0; s<Sources; s++) Pipeline.Feed(s,Pending[s].data(),Pending[s].size());
+  Pipeline.Flush();
+
+  CHECK(InOrder);
+  CHECK(Delivered==Sources*Messages);
+  CHECK(Pipeline.GetErrors()==0);
+}
+
+TEST_CASE("Pipeline errors and TAG blocks")
+{
+  std::vector<std::string> Codes;
+  tNMEA0183Pipeline<> Pipeline(0,
+    [&](const tNMEA0183Msg &Msg, const tNMEA0183NoResult &, bool) {
+      Codes.push_back(Msg.MessageCode());
+      if ( Msg.TagBlock().Flags & tNMEA0183TagBlock::tbSource ) Codes.back()+=Msg.TagBlock().Source;
+    },
+    2);
+  const char *Data=
+    "$GPZDA,160012.71,11,03,2004,-1,00*7D\r\n"
+    "garbage$GPZDA,160012.71,11,03,2004,-1,00*00\r\n"   // Wrong checksum
+    "$GPZDA,1600$SDDPT,2.0,0.0*55\r\n"                    // Restart before checksum
+    "\\s:r003669945,c:1241544035*79\\!AIVDM,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0*5C\r\n";
+
+  CHECK(Pipeline.Feed(0,Data,strlen(Data))==4);
+  Pipeline.Flush();
+  REQUIRE(Codes.size()==3);
+  CHECK(Codes[0]=="ZDA");
+  CHECK(Codes[1]=="DPT");
+  CHECK(Codes[2]=="VDMr003669945");
+  CHECK(Pipeline.GetErrors()==1);
+}
@@ -0,0 +1,92 @@
+/*
+PollerTest.cpp
+
+The MIT License
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+// \brief Tests for tNMEA0183Poller with pseudo terminals.
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <catch2/catch.hpp>
+#include <NMEA0183Poller.h>
+
+static std::vector<std::string> PollerMessages;
+
+static void CollectPollerMessage(const tNMEA0183Msg &NMEA0183Msg) {
+  PollerMessages.push_back(std::to_string(NMEA0183Msg.SourceID)+NMEA0183Msg.MessageCode());
+}
+
+// Open pseudo terminal master in raw mode. Returns slave device name on SlaveName.
+static int OpenPty(std::string &SlaveName) {
+  int fd=posix_openpt(O_RDWR | O_NOCTTY);
+  if ( fd==-1 || grantpt(fd)!=0 || unlockpt(fd)!=0 ) return -1;
+  struct termios tio;
+  tcgetattr(fd,&tio);
+  cfmakeraw(&tio);
+  tcsetattr(fd,TCSANOW,&tio);
+  SlaveName=ptsname(fd);
+  return fd;
+}
+
+TEST_CASE("Poller with many ports")
+{
+  const size_t Ports=8;
+  int Masters[Ports];
+  tNMEA0183Poller Poller(Ports);
+
+  PollerMessages.clear();
+  for (size_t i=0; i<Ports; i++) {
+    std::string SlaveName;
+    Masters[i]=OpenPty(SlaveName);
+    REQUIRE(Masters[i]!=-1);
+    tNMEA0183 *NMEA0183=Poller.AddPort(SlaveName.c_str(),i+1);
+    REQUIRE(NMEA0183!=0);
+    NMEA0183->SetMsgHandler(CollectPollerMessage);
+  }
+  CHECK(Poller.PortCount()==Ports);
+  CHECK(Poller.AddPort("/nonexistent/port",99)==0);
+
+  // Nothing to read
+  CHECK(Poller.Poll(0)==0);
+
+  const char *ZDA="$GPZDA,160012.71,11,03,2004,-1,00*7D\r\n";
+  const char *DPT="$IIDPT,10.5,0.9*7D\r\n";
+  CHECK(write(Masters[2],ZDA,strlen(ZDA))==(ssize_t)strlen(ZDA));
+  CHECK(write(Masters[6],DPT,strlen(DPT))==(ssize_t)strlen(DPT));
+
+  size_t MsgCount=0;
+  for (int i=0; i<10 && MsgCount<2; i++) MsgCount+=Poller.Poll(100);
+  CHECK(MsgCount==2);
+  REQUIRE(PollerMessages.size()==2);
+  CHECK(std::find(PollerMessages.begin(),PollerMessages.end(),"3ZDA")!=PollerMessages.end());
+  CHECK(std::find(PollerMessages.begin(),PollerMessages.end(),"7DPT")!=PollerMessages.end());
+
+  for (size_t i=0; i<Ports; i++) close(Masters[i]);
+}
@@ -0,0 +1,93 @@
+/*
+RxRingTest.cpp
+
+The MIT License
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+// \brief Tests for tNMEA0183RxRing and parsing from it.
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include <string.h>
+#include <catch2/catch.hpp>
+#include <NMEA0183.h>
+
+TEST_CASE("Ring wrap around")
+{
+  tNMEA0183RxRingT<8> Ring;
+  const char *data;
+
+  CHECK(Ring.Push("abcdef",6)==6);
+  CHECK(Ring.Read()=='a');
+  CHECK(Ring.ReadSpan(data)==5);
+  Ring.Consume(4);
+  CHECK(Ring.Push("ghijklmnop",10)==7);  // 1 byte left + 7 free
+  CHECK(Ring.GetOverruns()==3);
+  CHECK_FALSE(Ring.Push('x'));
+  CHECK(Ring.Available()==8);
+  CHECK(Ring.ReadSpan(data)==3);        // f, g and h until end of buffer
+  CHECK(strncmp(data,"fgh",3)==0);
+  Ring.Consume(3);
+  CHECK(Ring.ReadSpan(data)==5);
+  CHECK(strncmp(data,"ijklm",5)==0);
+}
+
+static size_t RingMsgCount=0;
+
+static void CountRingMessage(const tNMEA0183Msg &NMEA0183Msg) {
+  if ( NMEA0183Msg.IsMessageCode("ZDA") ) RingMsgCount++;
+}
+
+TEST_CASE("Parse from ring with producer thread")
+{
+  const char *Sentence="$GPZDA,160012.71,11,03,2004,-1,00*7D\r\n";
+  const size_t Messages=20000;
+  tNMEA0183RxRingT<256> Ring;
+  tNMEA0183 NMEA0183;
+  std::atomic<bool> Done(false);
+
+  NMEA0183.SetRxRing(&Ring);
+  NMEA0183.SetMsgHandler(CountRingMessage);
+  REQUIRE(NMEA0183.Open());
+  RingMsgCount=0;
+
+  // Thread stands for UART interrupt pushing bytes one by one.
+  std::thread Producer([&]() {
+    for (size_t i=0; i<Messages; i++) {
+      for (const char *p=Sentence; *p!=0; ) {
+        if ( Ring.Push(*p) ) p++; else std::this_thread::yield();
+      }
+    }
+    Done=true;
+  });
+
+  while ( !Done || Ring.Available()>0 ) {
+    NMEA0183.ParseMessages();
+    std::this_thread::yield();
+  }
+  Producer.join();
+
+  CHECK(RingMsgCount==Messages);
+  CHECK(NMEA0183.GetStats().Errors==0);
+}
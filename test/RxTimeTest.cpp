@@ -0,0 +1,160 @@
+/*
+RxTimeTest.cpp
+
+The MIT License
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+// \brief Tests for message receive times.
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <catch2/catch.hpp>
+#include <NMEA0183.h>
+#include <NMEA0183RxTime.h>
+#include <NMEA0183SerialStream.h>
+#include <NMEA0183Udp.h>
+
+static std::vector<uint64_t> RxTimes;
+
+static void CollectRxTime(const tNMEA0183Msg &NMEA0183Msg) {
+  RxTimes.push_back(NMEA0183Msg.RxTime());
+}
+
+static const uint64_t ms=1000000;
+
+TEST_CASE("Feed receive time")
+{
+  tNMEA0183 NMEA0183;
+  const uint64_t T=1700000000000000000ULL;
+  const char *Data="xx$IIDPT,10.5,0.9*7D\r\n$GPZDA,160012.71,";
+
+  RxTimes.clear();
+  // Times of message starts are interpolated from byte time.
+  NMEA0183.SetFeedTime(T,1000);
+  CHECK(NMEA0183.Feed(Data,strlen(Data),CollectRxTime)==1);
+  REQUIRE(RxTimes.size()==1);
+  CHECK(RxTimes[0]==T+2*1000);
+  // Message continued on next block keeps time of its start.
+  NMEA0183.SetFeedTime(T+ms);
+  CHECK(NMEA0183.Feed("11,03,2004,-1,00*7D\r\n",21,CollectRxTime)==1);
+  REQUIRE(RxTimes.size()==2);
+  CHECK(RxTimes[1]==T+22*1000);
+  // Time is valid only for one Feed.
+  CHECK(NMEA0183.Feed("$IIDPT,10.5,0.9*7D\r\n",20,CollectRxTime)==1);
+  REQUIRE(RxTimes.size()==3);
+  CHECK(RxTimes[2]==0);
+
+  // Messages set from buffer do not have receive time. Copy keeps it.
+  tNMEA0183Msg Msg, Copy;
+  REQUIRE(Msg.SetMessage("$IIDPT,10.5,0.9*7D"));
+  CHECK(Msg.RxTime()==0);
+  Msg.SetRxTime(T);
+  Copy=Msg;
+  CHECK(Copy.RxTime()==T);
+}
+
+TEST_CASE("Socket receive time")
+{
+  // Connected TCP pair on loopback
+  int Listen=socket(AF_INET,SOCK_STREAM,0);
+  struct sockaddr_in Addr;
+  socklen_t len=sizeof(Addr);
+  memset(&Addr,0,sizeof(Addr));
+  Addr.sin_family=AF_INET;
+  Addr.sin_addr.s_addr=htonl(INADDR_LOOPBACK);
+  REQUIRE(bind(Listen,(struct sockaddr *)&Addr,sizeof(Addr))==0);
+  REQUIRE(listen(Listen,1)==0);
+  REQUIRE(getsockname(Listen,(struct sockaddr *)&Addr,&len)==0);
+  int Client=socket(AF_INET,SOCK_STREAM,0);
+  REQUIRE(connect(Client,(struct sockaddr *)&Addr,sizeof(Addr))==0);
+  int Server=accept(Listen,0,0);
+  REQUIRE(Server!=-1);
+  REQUIRE(NMEA0183EnableRxTime(Server));
+
+  // Time is kernel time of arrival, not time of reading.
+  uint64_t Sent=NMEA0183RealTimeNs();
+  REQUIRE(send(Client,"$IIDPT,10.5,0.9*7D\r\n",20,0)==20);
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  char buf[64];
+  uint64_t RxTime=0;
+  CHECK(NMEA0183RecvTimed(Server,buf,sizeof(buf),0,RxTime)==20);
+  CHECK(RxTime>=Sent);
+  CHECK(RxTime<Sent+40*ms);
+
+  close(Client);
+  close(Server);
+  close(Listen);
+
+  // UDP receiver gives kernel time of datagram to messages.
+  tNMEA0183UdpReceiver Receiver(CollectRxTime);
+  REQUIRE(Receiver.Open(0,0,"127.0.0.1"));
+  int Sender=socket(AF_INET,SOCK_DGRAM,0);
+  Addr.sin_port=htons(Receiver.GetPort());
+  RxTimes.clear();
+  Sent=NMEA0183RealTimeNs();
+  CHECK(sendto(Sender,"$IIDPT,10.5,0.9*7D\r\n",20,0,(struct sockaddr *)&Addr,sizeof(Addr))==20);
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  CHECK(Receiver.Receive()==1);
+  REQUIRE(RxTimes.size()==1);
+  CHECK(RxTimes[0]>=Sent);
+  CHECK(RxTimes[0]<Sent+40*ms);
+  close(Sender);
+}
+
+TEST_CASE("Serial receive time interpolation")
+{
+  int Master=posix_openpt(O_RDWR | O_NOCTTY);
+  REQUIRE(Master!=-1);
+  REQUIRE(grantpt(Master)==0);
+  REQUIRE(unlockpt(Master)==0);
+  tNMEA0183SerialStream Stream(ptsname(Master),4800);
+  REQUIRE(Stream.IsOpen());
+  tNMEA0183 NMEA0183(&Stream);
+  NMEA0183.SetMsgHandler(CollectRxTime);
+  REQUIRE(NMEA0183.Open());
+
+  // At 4800 baud character takes 10/4800 s, so start of 40 character block
+  // arrived 39 character times before read.
+  const char *Data="$IIDPT,10.5,0.9*7D\r\n$IIDPT,10.5,0.9*7D\r\n";
+  const uint64_t ByteTime=10000000000ULL/4800;
+  RxTimes.clear();
+  REQUIRE(write(Master,Data,40)==40);
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  uint64_t Before=NMEA0183RealTimeNs();
+  NMEA0183.ParseMessages(1000);
+  uint64_t After=NMEA0183RealTimeNs();
+  REQUIRE(RxTimes.size()==2);
+  CHECK(RxTimes[0]>=Before-39*ByteTime);
+  CHECK(RxTimes[0]<=After-39*ByteTime);
+  CHECK(RxTimes[1]==RxTimes[0]+20*ByteTime);
+
+  close(Master);
+}
@@ -0,0 +1,96 @@
+/*
+SerialStreamTest.cpp
+
+The MIT License
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+// \brief Tests for tNMEA0183SerialStream with pseudo terminal.
+
+#include <string>
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <catch2/catch.hpp>
+#include <NMEA0183.h>
+#include <NMEA0183SerialStream.h>
+
+// Read from fd until Len bytes has been received or nothing comes in 1 s.
+static std::string ReadFd(int fd, size_t Len) {
+  std::string Data;
+  char buf[256];
+  struct pollfd pfd={fd,POLLIN,0};
+
+  while ( Data.size()<Len && poll(&pfd,1,1000)>0 ) {
+    ssize_t n=::read(fd,buf,sizeof(buf));
+    if ( n<=0 ) break;
+    Data.append(buf,n);
+  }
+  return Data;
+}
+
+TEST_CASE("Serial stream on pty")
+{
+  int Master=posix_openpt(O_RDWR | O_NOCTTY);
+  REQUIRE(Master!=-1);
+  REQUIRE(grantpt(Master)==0);
+  REQUIRE(unlockpt(Master)==0);
+
+  tNMEA0183SerialStream Stream(ptsname(Master),38400,true);
+  REQUIRE(Stream.IsOpen());
+  // Port, which could not be opened or configured, does not read or write stdin and stdout.
+  tNMEA0183SerialStream Failed(ptsname(Master),12345);
+  CHECK_FALSE(Failed.IsOpen());
+  CHECK(Failed.GetReadFd()==-1);
+  CHECK(Failed.GetWriteFd()==-1);
+  CHECK(Failed.write((const uint8_t *)"$",1)==0);
+  CHECK(Failed.read()==-1);
+  tNMEA0183SerialStream Missing("/nonexistent/port");
+  CHECK_FALSE(Missing.IsOpen());
+  CHECK(Missing.GetReadFd()==-1);
+  CHECK(Missing.write((const uint8_t *)"$",1)==0);
+
+  // Raw mode: CR LF passes unchanged and nothing is echoed.
+  const char *ZDA="$GPZDA,160012.71,11,03,2004,-1,00*7D\r\n";
+  REQUIRE(write(Master,ZDA,strlen(ZDA))==(ssize_t)strlen(ZDA));
+  struct pollfd pfd={Stream.GetReadFd(),POLLIN,0};
+  REQUIRE(poll(&pfd,1,1000)==1);
+  CHECK(Stream.available()==(int)strlen(ZDA));
+  CHECK(Stream.read()=='$');
+  uint8_t buf[100];
+  size_t n=Stream.read(buf,sizeof(buf));
+  CHECK(std::string((char *)buf,n)==ZDA+1);
+  CHECK(Stream.read()==-1);
+
+  // Sent message arrives to other end in one piece.
+  tNMEA0183 NMEA0183(&Stream);
+  tNMEA0183Msg Msg;
+  REQUIRE(NMEA0183.Open());
+  REQUIRE(Msg.SetMessage("$GPZDA,160012.71,11,03,2004,-1,00*7D"));
+  CHECK(NMEA0183.SendMessage(Msg));
+  CHECK(ReadFd(Master,strlen(ZDA))==ZDA);
+
+  close(Master);
+}
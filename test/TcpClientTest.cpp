@@ -0,0 +1,179 @@
+/*
+TcpClientTest.cpp
+
+The MIT License
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+// \brief Tests for tNMEA0183TcpClientStream with loopback test server.
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <string.h>
+#include <unistd.h>
+#include <poll.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <catch2/catch.hpp>
+#include <NMEA0183.h>
+#include <NMEA0183TcpClientStream.h>
+
+static std::vector<std::string> TcpMessages;
+
+static void CollectTcpMessage(const tNMEA0183Msg &NMEA0183Msg) {
+  char buf[100];
+  if ( NMEA0183Msg.GetMessage(buf,sizeof(buf)) ) TcpMessages.push_back(buf);
+}
+
+//-----------------------------------------------------------------------------
+// Loopback server accepting one client at time.
+class tTestServer {
+public:
+  int fd;
+  uint16_t Port;
+  tTestServer() : Port(0) {
+    struct sockaddr_in Addr;
+    socklen_t len=sizeof(Addr);
+    memset(&Addr,0,sizeof(Addr));
+    Addr.sin_family=AF_INET;
+    Addr.sin_addr.s_addr=htonl(INADDR_LOOPBACK);
+    fd=socket(AF_INET,SOCK_STREAM,0);
+    if ( bind(fd,(struct sockaddr *)&Addr,sizeof(Addr))==0 && listen(fd,4)==0 &&
+         getsockname(fd,(struct sockaddr *)&Addr,&len)==0 ) Port=ntohs(Addr.sin_port);
+  }
+  ~tTestServer() { close(fd); }
+  // Accept client. Parse messages meanwhile, so that client gets connected.
+  int Accept(tNMEA0183 &NMEA0183, tNMEA0183TcpClientStream &Stream) {
+    struct pollfd pfd={fd,POLLIN,0};
+    for (int i=0; i<200; i++) {
+      NMEA0183.ParseMessages();
+      Stream.IsConnected();
+      if ( poll(&pfd,1,10)==1 ) return accept(fd,0,0);
+    }
+    return -1;
+  }
+};
+
+static void Send(int fd, const char *Data) {
+  CHECK(write(fd,Data,strlen(Data))==(ssize_t)strlen(Data));
+}
+
+// Parse until Count messages has been received or 2 s has elapsed.
+static void ParseUntil(tNMEA0183 &NMEA0183, size_t Count) {
+  for (int i=0; i<200 && TcpMessages.size()<Count; i++) {
+    NMEA0183.ParseMessages();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+}
+
+TEST_CASE("TCP client reconnects")
+{
+  tTestServer Server;
+  REQUIRE(Server.Port!=0);
+  tNMEA0183TcpClientStream Stream("127.0.0.1",Server.Port,10,100);
+  tNMEA0183 NMEA0183(&Stream);
+  NMEA0183.SetMsgHandler(CollectTcpMessage);
+  REQUIRE(NMEA0183.Open());
+  TcpMessages.clear();
+
+  int Client=Server.Accept(NMEA0183,Stream);
+  REQUIRE(Client!=-1);
+  Send(Client,"$IIDPT,10.5,0.9*7D\r\n$GPZDA,1600");
+  ParseUntil(NMEA0183,1);
+  REQUIRE(TcpMessages.size()==1);
+  CHECK(Stream.IsConnected());
+
+  // Server drops connection in middle of sentence. Rest of sentence comes on new
+  // connection and must not be combined with start of it.
+  close(Client);
+  Client=Server.Accept(NMEA0183,Stream);
+  REQUIRE(Client!=-1);
+  Send(Client,"12.71,11,03,2004,-1,00*7D\r\n$IIDPT,10.5,0.9*7D\r\n");
+  ParseUntil(NMEA0183,2);
+  CHECK(Stream.GetConnects()==2);
+  REQUIRE(TcpMessages.size()==2);
+  CHECK(TcpMessages[1]=="$IIDPT,10.5,0.9*7D");
+
+  // Messages are sent to server
+  tNMEA0183Msg Msg;
+  REQUIRE(Msg.SetMessage("$GPZDA,160012.71,11,03,2004,-1,00*7D"));
+  CHECK(NMEA0183.SendMessage(Msg));
+  char buf[100];
+  struct pollfd pfd={Client,POLLIN,0};
+  REQUIRE(poll(&pfd,1,1000)==1);
+  ssize_t n=read(Client,buf,sizeof(buf));
+  CHECK(std::string(buf,(n>0?n:0))=="$GPZDA,160012.71,11,03,2004,-1,00*7D\r\n");
+  close(Client);
+}
+
+TEST_CASE("TCP client backoff")
+{
+  uint16_t Port;
+  { tTestServer Server; Port=Server.Port; } // Port without server
+  tNMEA0183TcpClientStream Stream("127.0.0.1",Port,20,40);
+  uint8_t buf[10];
+
+  auto start=std::chrono::steady_clock::now();
+  while ( std::chrono::steady_clock::now()-start<std::chrono::milliseconds(150) ) {
+    CHECK(Stream.read(buf,sizeof(buf))==0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  CHECK_FALSE(Stream.IsConnected());
+  CHECK(Stream.GetConnects()==0);
+}
+
+TEST_CASE("TCP client waits while not connected")
+{
+  uint16_t Port;
+  { tTestServer Server; Port=Server.Port; } // Port without server
+  tNMEA0183TcpClientStream Stream("127.0.0.1",Port,50,50);
+  tNMEA0183 NMEA0183(&Stream);
+  REQUIRE(NMEA0183.Open());
+
+  // Backoff is slept instead of returning at once.
+  auto start=std::chrono::steady_clock::now();
+  CHECK_FALSE(NMEA0183.WaitForData(120));
+  CHECK(std::chrono::steady_clock::now()-start>=std::chrono::milliseconds(100));
+  CHECK_FALSE(Stream.IsConnected());
+
+  // Connected stream waits data and returns, when it comes.
+  tTestServer Server;
+  REQUIRE(Server.Port!=0);
+  tNMEA0183TcpClientStream Stream2("127.0.0.1",Server.Port,10,100);
+  tNMEA0183 NMEA01832(&Stream2);
+  NMEA01832.SetMsgHandler(CollectTcpMessage);
+  REQUIRE(NMEA01832.Open());
+  TcpMessages.clear();
+  start=std::chrono::steady_clock::now();
+  CHECK_FALSE(NMEA01832.WaitForData(50));
+  CHECK(std::chrono::steady_clock::now()-start>=std::chrono::milliseconds(40));
+  CHECK(Stream2.IsConnected());
+  int Client=accept(Server.fd,0,0);
+  REQUIRE(Client!=-1);
+  Send(Client,"$IIDPT,10.5,0.9*7D\r\n");
+  CHECK(NMEA01832.WaitForData(1000));
+  NMEA01832.ParseMessages();
+  CHECK(TcpMessages.size()==1);
+  close(Client);
+}
@@ -0,0 +1,163 @@
+/*
+TcpServerTest.cpp
+
+The MIT License
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+// \brief Tests for tNMEA0183TcpServer.
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <catch2/catch.hpp>
+#include <NMEA0183TcpServer.h>
+
+static int ConnectLoopback(uint16_t Port) {
+  struct sockaddr_in Addr;
+  memset(&Addr,0,sizeof(Addr));
+  Addr.sin_family=AF_INET;
+  Addr.sin_port=htons(Port);
+  Addr.sin_addr.s_addr=htonl(INADDR_LOOPBACK);
+  int fd=socket(AF_INET,SOCK_STREAM,0);
+  if ( connect(fd,(struct sockaddr *)&Addr,sizeof(Addr))!=0 ) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+TEST_CASE("TCP server with many connections")
+{
+  const size_t Clients=20;
+  std::mutex Lock;
+  std::map<uint32_t,std::vector<std::string> > Received;
+  size_t Opened=0, Closed=0;
+  bool PeersOK=true;
+  bool OnCallerThread=false;
+  std::thread::id Caller=std::this_thread::get_id();
+
+  tNMEA0183TcpServer Server([&](const tNMEA0183Msg &Msg, uint32_t ConnectionID) {
+    std::lock_guard<std::mutex> lk(Lock);
+    Received[ConnectionID].push_back(Msg.Field(0));
+  },2);
+  Server.SetConnectionHandler([&](uint32_t, const struct sockaddr_in &Peer, bool Connected) {
+    std::lock_guard<std::mutex> lk(Lock);
+    if ( Peer.sin_addr.s_addr!=htonl(INADDR_LOOPBACK) ) PeersOK=false;  // Catch is not thread safe
+    if ( std::this_thread::get_id()==Caller ) OnCallerThread=true;
+    if ( Connected ) Opened++; else Closed++;
+  });
+  REQUIRE(Server.Open(0,"127.0.0.1"));
+  CHECK(Server.GetWorkerCount()==2);
+
+  std::vector<int> fds;
+  for (size_t i=0; i<Clients; i++) {
+    fds.push_back(ConnectLoopback(Server.GetPort()));
+    REQUIRE(fds.back()!=-1);
+  }
+  // Each client sends own depth value split to two writes.
+  for (size_t i=0; i<Clients; i++) {
+    std::string Sentence="$IIDPT,"+std::to_string(i)+",0.9*";
+    uint8_t cs=0;
+    for (size_t c=1; c<Sentence.size()-1; c++) cs^=Sentence[c];
+    char hex[3];
+    snprintf(hex,sizeof(hex),"%02X",cs);
+    Sentence+=std::string(hex)+"\r\n";
+    CHECK(write(fds[i],Sentence.data(),10)==10);
+    CHECK(write(fds[i],Sentence.data()+10,Sentence.size()-10)==(ssize_t)Sentence.size()-10);
+  }
+
+  for (int i=0; i<200; i++) {
+    { std::lock_guard<std::mutex> lk(Lock); if ( Received.size()==Clients ) break; }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  {
+    std::lock_guard<std::mutex> lk(Lock);
+    REQUIRE(Received.size()==Clients);
+    CHECK(Opened==Clients);
+    std::map<std::string,int> Values;
+    for (auto &r : Received) {
+      CHECK(r.second.size()==1);
+      Values[r.second[0]]++;
+    }
+    CHECK(Values.size()==Clients);
+  }
+
+  std::vector<tNMEA0183ConnectionStats> Stats;
+  Server.GetConnectionStats(Stats);
+  REQUIRE(Stats.size()==Clients);
+  for (size_t i=0; i<Stats.size(); i++) {
+    CHECK(Stats[i].Messages==1);
+    CHECK(Stats[i].Bytes>=17);
+    CHECK(Stats[i].Errors==0);
+  }
+
+  for (size_t i=0; i<Clients/2; i++) close(fds[i]);
+  for (int i=0; i<200 && Server.GetConnectionCount()>Clients-Clients/2; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  CHECK(Server.GetConnectionCount()==Clients-Clients/2);
+  Server.Close();
+  CHECK(Closed==Clients);
+  CHECK(PeersOK);
+  CHECK_FALSE(OnCallerThread);
+  for (size_t i=Clients/2; i<Clients; i++) close(fds[i]);
+}
+
+TEST_CASE("TCP server connection limit")
+{
+  const size_t Clients=20, MaxConnections=5;
+  std::mutex Lock;
+  size_t Opened=0;
+
+  tNMEA0183TcpServer Server([](const tNMEA0183Msg &, uint32_t) {},4,MaxConnections);
+  Server.SetConnectionHandler([&](uint32_t, const struct sockaddr_in &, bool Connected) {
+    std::lock_guard<std::mutex> lk(Lock);
+    if ( Connected ) Opened++;
+  });
+  REQUIRE(Server.Open(0,"127.0.0.1"));
+
+  std::vector<int> fds;
+  for (size_t i=0; i<Clients; i++) {
+    int fd=ConnectLoopback(Server.GetPort());
+    if ( fd!=-1 ) fds.push_back(fd);
+  }
+  for (int i=0; i<200 && Server.GetConnectionCount()<MaxConnections; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));  // Let workers handle rest
+  CHECK(Server.GetConnectionCount()==MaxConnections);
+  {
+    std::lock_guard<std::mutex> lk(Lock);
+    CHECK(Opened==MaxConnections);
+  }
+  Server.Close();
+  CHECK(Server.GetConnectionCount()==0);
+  for (size_t i=0; i<fds.size(); i++) close(fds[i]);
+}
@@ -0,0 +1,119 @@
+/*
+UdpTest.cpp
+
+The MIT License
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+// \brief Tests for tNMEA0183UdpReceiver on loopback.
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <catch2/catch.hpp>
+#include <NMEA0183Udp.h>
+
+static std::vector<std::string> UdpMessages;
+
+static void CollectUdpMessage(const tNMEA0183Msg &NMEA0183Msg) {
+  UdpMessages.push_back(std::to_string(NMEA0183Msg.SourceID)+NMEA0183Msg.MessageCode());
+}
+
+static void SendDatagram(int fd, uint16_t Port, const char *Data) {
+  struct sockaddr_in Addr;
+  memset(&Addr,0,sizeof(Addr));
+  Addr.sin_family=AF_INET;
+  Addr.sin_port=htons(Port);
+  Addr.sin_addr.s_addr=htonl(INADDR_LOOPBACK);
+  CHECK(sendto(fd,Data,strlen(Data),0,(struct sockaddr *)&Addr,sizeof(Addr))==(ssize_t)strlen(Data));
+}
+
+TEST_CASE("UDP receiver")
+{
+  tNMEA0183UdpReceiver Receiver(CollectUdpMessage,10);
+  REQUIRE(Receiver.Open(0,0,"127.0.0.1"));
+  uint16_t Port=Receiver.GetPort();
+  REQUIRE(Port!=0);
+
+  int Sender1=socket(AF_INET,SOCK_DGRAM,0);
+  int Sender2=socket(AF_INET,SOCK_DGRAM,0);
+  UdpMessages.clear();
+
+  CHECK(Receiver.Receive()==0);
+  // Several sentences on one datagram and more datagrams than one batch.
+  SendDatagram(Sender1,Port,"$GPZDA,160012.71,11,03,2004,-1,00*7D\r\n$IIDPT,10.5,0.9*7D\r\n");
+  for (int i=0; i<MAX_NMEA0183_UDP_BATCH; i++) SendDatagram(Sender2,Port,"$IIDPT,10.5,0.9*7D\r\n");
+  // Sentence split to two datagrams is dropped.
+  SendDatagram(Sender1,Port,"$GPZDA,160012.71,11,");
+  SendDatagram(Sender1,Port,"03,2004,-1,00*7D\r\n");
+  // Too long datagram is dropped.
+  std::string Long(MAX_NMEA0183_UDP_DATAGRAM_LEN,' ');
+  Long+="$IIDPT,10.5,0.9*7D\r\n";
+  SendDatagram(Sender1,Port,Long.c_str());
+
+  CHECK(Receiver.Receive()==2+MAX_NMEA0183_UDP_BATCH);
+  CHECK(std::count(UdpMessages.begin(),UdpMessages.end(),"10ZDA")==1);
+  CHECK(std::count(UdpMessages.begin(),UdpMessages.end(),"10DPT")==1);
+  CHECK(std::count(UdpMessages.begin(),UdpMessages.end(),"11DPT")==MAX_NMEA0183_UDP_BATCH);
+
+  struct sockaddr_in Addr;
+  REQUIRE(Receiver.GetSender(11,Addr));
+  CHECK(Addr.sin_addr.s_addr==htonl(INADDR_LOOPBACK));
+  CHECK_FALSE(Receiver.GetSender(12,Addr));
+  CHECK(Receiver.GetDropped()==0);
+  CHECK(Receiver.GetTruncated()==1);
+
+  close(Sender1);
+  close(Sender2);
+}
+
+TEST_CASE("UDP multicast receiver")
+{
+  tNMEA0183UdpReceiver Receiver(CollectUdpMessage);
+  if ( !Receiver.Open(0,"239.192.0.10","127.0.0.1") ) { WARN("Multicast not available"); return; }
+  uint16_t Port=Receiver.GetPort();
+
+  int Sender=socket(AF_INET,SOCK_DGRAM,0);
+  struct in_addr If;
+  If.s_addr=htonl(INADDR_LOOPBACK);
+  REQUIRE(setsockopt(Sender,IPPROTO_IP,IP_MULTICAST_IF,&If,sizeof(If))==0);
+  struct sockaddr_in Addr;
+  memset(&Addr,0,sizeof(Addr));
+  Addr.sin_family=AF_INET;
+  Addr.sin_port=htons(Port);
+  inet_pton(AF_INET,"239.192.0.10",&Addr.sin_addr);
+  const char *DPT="$IIDPT,10.5,0.9*7D\r\n";
+  CHECK(sendto(Sender,DPT,strlen(DPT),0,(struct sockaddr *)&Addr,sizeof(Addr))==(ssize_t)strlen(DPT));
+  UdpMessages.clear();
+
+  size_t MsgCount=0;
+  for (int i=0; i<100 && MsgCount==0; i++) {
+    MsgCount=Receiver.Receive();
+    if ( MsgCount==0 ) usleep(1000);
+  }
+  CHECK(MsgCount==1);
+  close(Sender);
+}
@@ -0,0 +1,164 @@
+/*
+UringTest.cpp
+
+The MIT License
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+// \brief Tests for tNMEA0183UringReader.
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <catch2/catch.hpp>
+#include <NMEA0183Uring.h>
+
+#ifdef NMEA0183_HAS_URING
+
+static std::vector<std::string> UringMessages;
+
+static void CollectUringMessage(const tNMEA0183Msg &NMEA0183Msg) {
+  UringMessages.push_back(std::to_string(NMEA0183Msg.SourceID)+NMEA0183Msg.MessageCode());
+}
+
+TEST_CASE("io_uring reader")
+{
+  tNMEA0183UringReader Reader(4,64);
+  if ( !Reader.IsOpen() ) { WARN("io_uring not available"); return; }
+
+  int Blocking[2], NonBlocking[2];
+  REQUIRE(socketpair(AF_UNIX,SOCK_STREAM,0,Blocking)==0);
+  REQUIRE(socketpair(AF_UNIX,SOCK_STREAM,0,NonBlocking)==0);
+  fcntl(NonBlocking[0],F_SETFL,O_NONBLOCK);
+  tNMEA0183 Port1(0,1), Port2(0,2);
+  Port1.SetMsgHandler(CollectUringMessage);
+  Port2.SetMsgHandler(CollectUringMessage);
+  REQUIRE(Reader.Add(Blocking[0],&Port1));
+  REQUIRE(Reader.Add(NonBlocking[0],&Port2));
+  CHECK(Reader.SourceCount()==2);
+  UringMessages.clear();
+
+  CHECK(Reader.Poll(0)==0);
+
+  // Longer than buffer, so it takes several reads.
+  std::string Data;
+  for (int i=0; i<5; i++) Data+="$GPZDA,160012.71,11,03,2004,-1,00*7D\r\n";
+  CHECK(write(Blocking[1],Data.data(),Data.size())==(ssize_t)Data.size());
+  const char *DPT="$IIDPT,10.5,0.9*7D\r\n";
+  CHECK(write(NonBlocking[1],DPT,strlen(DPT))==(ssize_t)strlen(DPT));
+
+  size_t MsgCount=0;
+  for (int i=0; i<50 && MsgCount<6; i++) MsgCount+=Reader.Poll(100);
+  CHECK(MsgCount==6);
+  CHECK(std::count(UringMessages.begin(),UringMessages.end(),"1ZDA")==5);
+  CHECK(std::count(UringMessages.begin(),UringMessages.end(),"2DPT")==1);
+
+  // Removed source is not read any more and closed one is dropped.
+  CHECK(Reader.Remove(&Port2));
+  close(Blocking[1]);
+  for (int i=0; i<50 && Reader.SourceCount()>0; i++) Reader.Poll(10);
+  CHECK(Reader.SourceCount()==0);
+  CHECK(write(NonBlocking[1],DPT,strlen(DPT))==(ssize_t)strlen(DPT));
+  Reader.Poll(10);
+  CHECK(UringMessages.size()==6);
+
+  close(Blocking[0]);
+  close(NonBlocking[0]);
+  close(NonBlocking[1]);
+}
+
+static tNMEA0183UringReader *RemovingReader=0;
+static tNMEA0183 *RemovingPort=0;
+
+static void RemoveOnMessage(const tNMEA0183Msg &NMEA0183Msg) {
+  CollectUringMessage(NMEA0183Msg);
+  RemovingReader->Remove(RemovingPort);
+}
+
+TEST_CASE("io_uring source removed from its handler")
+{
+  tNMEA0183UringReader Reader(1,64);
+  if ( !Reader.IsOpen() ) { WARN("io_uring not available"); return; }
+
+  int fds1[2], fds2[2];
+  REQUIRE(socketpair(AF_UNIX,SOCK_STREAM,0,fds1)==0);
+  REQUIRE(socketpair(AF_UNIX,SOCK_STREAM,0,fds2)==0);
+  tNMEA0183 Port1(0,1), Port2(0,2);
+  Port1.SetMsgHandler(RemoveOnMessage);
+  Port2.SetMsgHandler(CollectUringMessage);
+  RemovingReader=&Reader;
+  RemovingPort=&Port1;
+  UringMessages.clear();
+
+  REQUIRE(Reader.Add(fds1[0],&Port1));
+  CHECK_FALSE(Reader.Add(fds2[0],&Port2)); // Only one slot
+  const char *DPT="$IIDPT,10.5,0.9*7D\r\n";
+  CHECK(write(fds1[1],DPT,strlen(DPT))==(ssize_t)strlen(DPT));
+  for (int i=0; i<50 && UringMessages.empty(); i++) Reader.Poll(100);
+  REQUIRE(UringMessages.size()==1);
+  CHECK(Reader.SourceCount()==0);
+
+  // Slot has been freed, so new source can use it.
+  REQUIRE(Reader.Add(fds2[0],&Port2));
+  CHECK(write(fds2[1],DPT,strlen(DPT))==(ssize_t)strlen(DPT));
+  for (int i=0; i<50 && UringMessages.size()<2; i++) Reader.Poll(100);
+  REQUIRE(UringMessages.size()==2);
+  CHECK(UringMessages[1]=="2DPT");
+  // Removed source is not read any more.
+  CHECK(write(fds1[1],DPT,strlen(DPT))==(ssize_t)strlen(DPT));
+  Reader.Poll(10);
+  CHECK(UringMessages.size()==2);
+
+  for (int i=0; i<2; i++) { close(fds1[i]); close(fds2[i]); }
+}
+
+TEST_CASE("io_uring reader destroyed with reads in flight")
+{
+  int Blocking[2], NonBlocking[2];
+  REQUIRE(socketpair(AF_UNIX,SOCK_STREAM,0,Blocking)==0);
+  REQUIRE(socketpair(AF_UNIX,SOCK_STREAM,0,NonBlocking)==0);
+  fcntl(NonBlocking[0],F_SETFL,O_NONBLOCK);
+  tNMEA0183 Port1(0,1), Port2(0,2);
+  {
+    tNMEA0183UringReader Reader(2,64);
+    if ( !Reader.IsOpen() ) { WARN("io_uring not available"); return; }
+    REQUIRE(Reader.Add(Blocking[0],&Port1));
+    REQUIRE(Reader.Add(NonBlocking[0],&Port2));
+    Reader.Poll(0);
+  }
+
+  // Requests have been cancelled, so data written after is not taken by them.
+  const char *DPT="$IIDPT,10.5,0.9*7D\r\n";
+  char buf[64];
+  CHECK(write(Blocking[1],DPT,strlen(DPT))==(ssize_t)strlen(DPT));
+  CHECK(read(Blocking[0],buf,sizeof(buf))==(ssize_t)strlen(DPT));
+  CHECK(write(NonBlocking[1],DPT,strlen(DPT))==(ssize_t)strlen(DPT));
+  CHECK(read(NonBlocking[0],buf,sizeof(buf))==(ssize_t)strlen(DPT));
+
+  for (int i=0; i<2; i++) { close(Blocking[i]); close(NonBlocking[i]); }
+}
+
+#endif
@@ -0,0 +1,128 @@
+/*
+WaitTest.cpp
+
+The MIT License
+
+Copyright (c) 2015-2024 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+// \brief Tests for waiting data on descriptor and descriptor events.
+
+#include <chrono>
+#include <thread>
+
+#include <string>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <string.h>
+#include <catch2/catch.hpp>
+#include <NMEA0183.h>
+
+//-----------------------------------------------------------------------------
+// Non blocking stream on one end of socket pair. Test uses other end fds[1].
+class tSocketStream : public tNMEA0183Stream {
+public:
+  int fds[2];
+  tSocketStream() {
+    if ( socketpair(AF_UNIX,SOCK_STREAM,0,fds)==0 ) fcntl(fds[0],F_SETFL,O_NONBLOCK);
+  }
+  ~tSocketStream() { close(fds[0]); close(fds[1]); }
+  int read() { uint8_t c; return ( ::read(fds[0],&c,1)==1?c:-1 ); }
+  size_t read(uint8_t *buf, size_t max) { ssize_t n=::read(fds[0],buf,max); return ( n>0?n:0 ); }
+  size_t write(const uint8_t* data, size_t size) { ssize_t n=::write(fds[0],data,size); return ( n>0?n:0 ); }
+  int GetReadFd() const { return fds[0]; }
+  int GetWriteFd() const { return fds[0]; }
+};
+
+static size_t WaitMsgCount=0;
+
+static void CountWaitMessage(const tNMEA0183Msg &NMEA0183Msg) {
+  (void)NMEA0183Msg;
+  WaitMsgCount++;
+}
+
+TEST_CASE("Wait for data")
+{
+  const char *Sentence="$GPZDA,160012.71,11,03,2004,-1,00*7D\r\n";
+  tSocketStream Stream;
+  tNMEA0183 NMEA0183(&Stream);
+
+  NMEA0183.SetMsgHandler(CountWaitMessage);
+  REQUIRE(NMEA0183.Open());
+  WaitMsgCount=0;
+
+  auto start=std::chrono::steady_clock::now();
+  CHECK_FALSE(NMEA0183.WaitForData(20));
+  CHECK(std::chrono::steady_clock::now()-start>=std::chrono::milliseconds(20));
+
+  std::thread Writer([&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    CHECK(::write(Stream.fds[1],Sentence,strlen(Sentence))==(ssize_t)strlen(Sentence));
+  });
+  NMEA0183.ParseMessages(5000);
+  Writer.join();
+  CHECK(WaitMsgCount==1);
+  CHECK(std::chrono::steady_clock::now()-start<std::chrono::milliseconds(5000));
+}
+
+TEST_CASE("Descriptor events")
+{
+  const char *Sentence="$GPZDA,160012.71,11,03,2004,-1,00*7D\r\n";
+  tSocketStream Stream;
+  tNMEA0183 NMEA0183(&Stream);
+  tNMEA0183Msg Msg;
+  std::string Data;
+
+  NMEA0183.SetMsgHandler(CountWaitMessage);
+  REQUIRE(NMEA0183.Open());
+  CHECK(NMEA0183.GetReadFd()==Stream.fds[0]);
+  WaitMsgCount=0;
+
+  // Readable drains all data.
+  for (int i=0; i<200; i++) Data+=Sentence;
+  CHECK(::write(Stream.fds[1],Data.data(),Data.size())==(ssize_t)Data.size());
+  CHECK(NMEA0183.OnReadable()==200);
+  CHECK(WaitMsgCount==200);
+  CHECK(NMEA0183.OnReadable()==0);
+
+  // Fill socket so that sending must be buffered.
+  char Fill[4096];
+  memset(Fill,'x',sizeof(Fill));
+  size_t Filled=0;
+  for (ssize_t n; (n=::write(Stream.fds[0],Fill,sizeof(Fill)))>0; ) Filled+=n;
+  REQUIRE(Msg.SetMessage("$GPZDA,160012.71,11,03,2004,-1,00*7D"));
+  CHECK(NMEA0183.SendMessage(Msg));
+  CHECK(NMEA0183.HasPendingOutput());
+  CHECK_FALSE(NMEA0183.OnWritable());
+
+  // Read peer side empty and let tNMEA0183 write buffered message.
+  std::string Received;
+  char buf[4096];
+  while ( Received.size()<Filled+strlen(Sentence) ) {
+    ssize_t n=::read(Stream.fds[1],buf,sizeof(buf));
+    REQUIRE(n>0);
+    Received.append(buf,n);
+    NMEA0183.OnWritable();
+  }
+  CHECK_FALSE(NMEA0183.HasPendingOutput());
+  CHECK(Received.substr(Filled)==Sentence);
+}